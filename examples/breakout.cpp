@@ -9,12 +9,15 @@
  * - Particle effects for destruction
  * - Power-ups and special blocks
  * - Lives system and game over conditions
+ * - Cached static layers for the block field
  */
 
 #include "../include/engine.hpp"
 #include "../include/objects.hpp"
 #include "../include/rigidbody.hpp"
 #include "../include/rigidobject.hpp"
+#include "../include/layer.hpp"
+#include "../include/narrowphase.hpp"
 #include <iostream>
 #include <vector>
 #include <cmath>
@@ -39,6 +42,7 @@ public:
         // Change color based on remaining hits
         if (hits == 1) {
             FillColor = CacoEngine::Colors[(int)CacoEngine::Color::Red];
+            SetFillColor(FillColor);
         }
         return false;
     }
@@ -50,6 +54,9 @@ private:
     std::shared_ptr<CacoEngine::Rectangle> paddle;
     std::shared_ptr<CacoEngine::RigidCircle> ball;
     std::vector<std::shared_ptr<Block>> blocks;
+
+    // Blocks rarely change, so they are drawn once into a cached layer
+    std::shared_ptr<CacoEngine::Layer> blockLayer;
     
     // Game state
     int score = 0;
@@ -83,6 +90,9 @@ public:
         std::cout << "Space - Launch ball" << std::endl;
         std::cout << "R - Restart (when game over)" << std::endl;
         
+        blockLayer = std::make_shared<CacoEngine::Layer>();
+        AddDrawable(blockLayer);
+
         InitializeGame();
     }
     
@@ -124,6 +134,7 @@ public:
     
     void CreateBlocks() {
         blocks.clear();
+        blockLayer->Clear();
         
         int rows = 5 + level; // More rows each level
         int cols = 10;
@@ -156,7 +167,7 @@ public:
                 );
                 
                 blocks.push_back(block);
-                AddObject(block);
+                blockLayer->AddObject(block);
             }
         }
     }
@@ -224,27 +235,31 @@ public:
         for (auto it = blocks.begin(); it != blocks.end();) {
             auto block = *it;
             
+            CacoEngine::AABB bounds(block->Position.X, block->Position.Y,
+                                    block->Position.X + BLOCK_WIDTH, block->Position.Y + BLOCK_HEIGHT);
+            CacoEngine::Contact contact;
+            
             if (!block->destroyed &&
-                ball->Position.X + BALL_RADIUS >= block->Position.X &&
-                ball->Position.X - BALL_RADIUS <= block->Position.X + BLOCK_WIDTH &&
-                ball->Position.Y + BALL_RADIUS >= block->Position.Y &&
-                ball->Position.Y - BALL_RADIUS <= block->Position.Y + BLOCK_HEIGHT) {
+                CacoEngine::Narrowphase::TestCircleBox(ball->Position, BALL_RADIUS, bounds, &contact)) {
                 
-                // Simple bounce - could be improved with better collision detection
-                ball->Physics.Velocity.Y *= -1;
+                // Bounce off the face that was hit, sides flip X, top and bottom flip Y
+                if (std::fabs(contact.Normal.X) > std::fabs(contact.Normal.Y)) {
+                    ball->Physics.Velocity.X *= -1;
+                } else {
+                    ball->Physics.Velocity.Y *= -1;
+                }
                 
                 if (block->Hit()) {
                     score += block->points;
                     std::cout << "Block destroyed! Score: " << score << std::endl;
                     
-                    // Remove from visual objects
-                    auto objIt = std::find(Objects.begin(), Objects.end(), block);
-                    if (objIt != Objects.end()) {
-                        Objects.erase(objIt);
-                    }
+                    // Remove from the cached block layer
+                    blockLayer->RemoveObject(block);
                     
                     it = blocks.erase(it);
                 } else {
+                    // Block changed color, re-render the layer
+                    blockLayer->Invalidate();
                     ++it;
                 }
                 break;
@@ -0,0 +1,103 @@
+/**
+ * Engine Checks - CacoEngine Example
+ *
+ * Features Demonstrated:
+ * - Driving engine subsystems without a window or renderer
+ * - Edge cases that used to crash or throw, kept as quick regression checks
+ * - Rejecting malformed BMFont descriptors
+ *
+ * Usage: ./engine_checks
+ * Runs headless and exits with a non-zero status when a check fails.
+ */
+
+#include "../include/animation.hpp"
+#include "../include/objects.hpp"
+#include "../include/renderer.hpp"
+#include "../include/text.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS  " : "FAIL  ") << name << std::endl;
+
+    if (!condition)
+        failures++;
+}
+
+// A clip played backwards has to wrap into its own frames, never below the first
+static void checkReversedClip(bool loop) {
+    auto sheet = std::make_shared<CacoEngine::SpriteSheet>(CacoEngine::Texture(), CacoEngine::Vector2D(64, 16));
+    sheet->AddGrid(CacoEngine::Vector2D(16, 16));
+
+    CacoEngine::AnimationSystem animations;
+
+    int clip = animations.AddClip(CacoEngine::AnimationClip(sheet, { 0, 1, 2, 3 }, 0.1f, loop));
+    int animator = animations.AddAnimator(std::make_shared<CacoEngine::Rectangle>(CacoEngine::Vector2Df(16, 16), CacoEngine::Vector2Df()), clip);
+
+    animations.SetSpeed(animator, -1.0f);
+
+    bool inRange = true, wrapped = false;
+
+    for (int step = 0; step < 100; step++) {
+        animations.Update(1.0 / 60.0);
+
+        int frame = animations.GetFrame(animator);
+
+        inRange = inRange && frame >= 0 && frame < 4;
+        wrapped = wrapped || frame == 3;
+    }
+
+    std::string name = loop ? "reversed looping clip" : "reversed one-shot clip";
+
+    check(inRange, name + " stays within its frames");
+
+    if (loop)
+        check(wrapped && animations.IsPlaying(animator), name + " wraps to its last frame");
+    else
+        check(animations.GetFrame(animator) == 0 && !animations.IsPlaying(animator), name + " stops on its first frame");
+}
+
+// A malformed font descriptor is rejected before any texture is loaded, so no window is needed
+static void checkMalformedBMFont(const std::string& name, const std::string& descriptor) {
+    const std::string path = "engine_checks_font.fnt";
+
+    std::ofstream(path) << descriptor;
+
+    CacoEngine::Renderer renderer;
+
+    bool threw = false;
+    std::shared_ptr<CacoEngine::BitmapFont> font;
+
+    try {
+        font = CacoEngine::BitmapFont::LoadBMFont(path, renderer);
+    } catch (...) {
+        threw = true;
+    }
+
+    std::remove(path.c_str());
+
+    check(!threw && !font, "font with " + name + " is rejected without throwing");
+}
+
+int main() {
+    std::cout << "=== ENGINE CHECKS ===" << std::endl;
+
+    checkReversedClip(true);
+    checkReversedClip(false);
+
+    checkMalformedBMFont("a non-numeric line height", "common lineHeight=tall base=26\npage id=0 file=\"font.png\"\n");
+    checkMalformedBMFont("an out of range line height", "common lineHeight=99999999999 base=26\npage id=0 file=\"font.png\"\n");
+    checkMalformedBMFont("a non-numeric character field", "common lineHeight=32\npage id=0 file=\"font.png\"\nchar id=65 x=abc y=0 width=8 height=8 xoffset=0 yoffset=0 xadvance=8\n");
+    checkMalformedBMFont("a missing character field", "common lineHeight=32\npage id=0 file=\"font.png\"\nchar id=65 x=0 y=0 width=8 height=8 xoffset=0 yoffset=0\n");
+    checkMalformedBMFont("a trailing garbage field", "common lineHeight=32\npage id=0 file=\"font.png\"\nchar id=65 x=0 y=0 width=8px height=8 xoffset=0 yoffset=0 xadvance=8\n");
+    checkMalformedBMFont("no page", "common lineHeight=32\n");
+
+    std::cout << (failures ? std::to_string(failures) + " check(s) failed" : std::string("All checks passed")) << std::endl;
+
+    return failures ? 1 : 0;
+}
@@ -9,159 +9,24 @@
  * - Dynamic object management
  * - Visual effects and animations
  * - Performance considerations with many objects
+ * - Engine particle system with emitters and batched drawing
  */
 
 #include "../include/engine.hpp"
 #include "../include/objects.hpp"
 #include "../include/rigidbody.hpp"
 #include "../include/rigidobject.hpp"
+#include "../include/particles.hpp"
 #include <iostream>
 #include <vector>
 #include <cmath>
-#include <random>
-
-class Particle : public CacoEngine::RigidObject2D {
-public:
-    float lifetime = 2.0f;
-    float maxLifetime = 2.0f;
-    CacoEngine::RGBA originalColor;
-    
-    Particle(CacoEngine::Vector2Df pos, CacoEngine::Vector2Df vel, CacoEngine::RGBA color, float life = 2.0f)
-        : RigidObject2D(pos, 2.0f), maxLifetime(life), lifetime(life), originalColor(color) {
-        Physics.Velocity = vel;
-        Physics.Acceleration = CacoEngine::Vector2Df(0, 100); // Gravity
-        FillColor = color;
-        FillMode = CacoEngine::RasterizeMode::SolidColor;
-    }
-    
-    void Update(double deltaTime) {
-        lifetime -= deltaTime;
-        
-        // Fade out over time
-        float alpha = (lifetime / maxLifetime) * 255.0f;
-        FillColor.A = std::max(0, (int)alpha);
-        
-        // Apply some friction
-        Physics.Velocity.X *= 0.99f;
-        Physics.Velocity.Y *= 0.99f;
-    }
-    
-    bool IsExpired() {
-        return lifetime <= 0;
-    }
-};
-
-class ParticleSystem {
-private:
-    std::vector<std::shared_ptr<Particle>> particles;
-    std::mt19937 rng;
-    
-public:
-    ParticleSystem() : rng(std::random_device{}()) {}
-    
-    void CreateExplosion(CacoEngine::Vector2Df position, int count = 50) {
-        std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * M_PI);
-        std::uniform_real_distribution<float> speedDist(50.0f, 200.0f);
-        std::uniform_real_distribution<float> lifeDist(1.0f, 3.0f);
-        std::uniform_int_distribution<int> colorDist(0, 4);
-        
-        for (int i = 0; i < count; i++) {
-            float angle = angleDist(rng);
-            float speed = speedDist(rng);
-            float life = lifeDist(rng);
-            
-            CacoEngine::Vector2Df velocity(
-                cos(angle) * speed,
-                sin(angle) * speed
-            );
-            
-            auto particle = std::make_shared<Particle>(
-                position,
-                velocity,
-                CacoEngine::Colors[colorDist(rng)],
-                life
-            );
-            
-            particles.push_back(particle);
-        }
-    }
-    
-    void CreateFirework(CacoEngine::Vector2Df position) {
-        std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * M_PI);
-        std::uniform_real_distribution<float> speedDist(100.0f, 300.0f);
-        
-        // Create circular pattern
-        for (int i = 0; i < 30; i++) {
-            float angle = (i / 30.0f) * 2.0f * M_PI;
-            float speed = speedDist(rng);
-            
-            CacoEngine::Vector2Df velocity(
-                cos(angle) * speed,
-                sin(angle) * speed
-            );
-            
-            auto particle = std::make_shared<Particle>(
-                position,
-                velocity,
-                CacoEngine::Colors[(i % 5)],
-                2.5f
-            );
-            
-            particles.push_back(particle);
-        }
-    }
-    
-    void CreateTrail(CacoEngine::Vector2Df position, CacoEngine::Vector2Df direction) {
-        std::uniform_real_distribution<float> spreadDist(-0.5f, 0.5f);
-        std::uniform_real_distribution<float> speedDist(20.0f, 80.0f);
-        
-        for (int i = 0; i < 10; i++) {
-            CacoEngine::Vector2Df velocity = direction;
-            velocity.X += spreadDist(rng) * 50.0f;
-            velocity.Y += spreadDist(rng) * 50.0f;
-            
-            float speed = speedDist(rng);
-            velocity = velocity * (speed / velocity.DistanceFrom(CacoEngine::Vector2Df(0, 0)));
-            
-            auto particle = std::make_shared<Particle>(
-                position,
-                velocity,
-                CacoEngine::Colors[(int)CacoEngine::Color::White],
-                1.0f
-            );
-            
-            particles.push_back(particle);
-        }
-    }
-    
-    void Update(double deltaTime) {
-        for (auto it = particles.begin(); it != particles.end();) {
-            (*it)->Update(deltaTime);
-            
-            if ((*it)->IsExpired()) {
-                it = particles.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    }
-    
-    std::vector<std::shared_ptr<Particle>>& GetParticles() {
-        return particles;
-    }
-    
-    void Clear() {
-        particles.clear();
-    }
-    
-    size_t GetParticleCount() {
-        return particles.size();
-    }
-};
 
 class ParticleDemo : public CacoEngine::Engine {
 private:
-    ParticleSystem particleSystem;
+    std::shared_ptr<CacoEngine::ParticleSystem> particleSystem;
+    int explosionEmitter = 0;
+    int fireworkEmitter = 0;
+    int trailEmitter = 0;
     
     // Demo objects
     std::vector<std::shared_ptr<CacoEngine::Circle>> attractors;
@@ -207,6 +72,38 @@ public:
     }
     
     void SetupDemo() {
+        particleSystem = std::make_shared<CacoEngine::ParticleSystem>(50000);
+        particleSystem->Gravity = CacoEngine::Vector2Df(0, 100);
+        particleSystem->Drag = 0.6f; // Some friction
+        AddDrawable(particleSystem);
+        
+        std::vector<CacoEngine::RGBA> palette(CacoEngine::Colors, CacoEngine::Colors + 5);
+        
+        CacoEngine::ParticleEmitter explosion(CacoEngine::EmitterShape::Point);
+        explosion.MinSpeed = 50.0f;
+        explosion.MaxSpeed = 200.0f;
+        explosion.MinLifetime = 1.0f;
+        explosion.MaxLifetime = 3.0f;
+        explosion.Palette = palette;
+        explosionEmitter = particleSystem->AddEmitter(explosion);
+        
+        CacoEngine::ParticleEmitter firework(CacoEngine::EmitterShape::Ring);
+        firework.Extents = CacoEngine::Vector2Df(5, 5);
+        firework.MinSpeed = 100.0f;
+        firework.MaxSpeed = 300.0f;
+        firework.MinLifetime = 2.5f;
+        firework.MaxLifetime = 2.5f;
+        firework.Palette = palette;
+        fireworkEmitter = particleSystem->AddEmitter(firework);
+        
+        CacoEngine::ParticleEmitter trail(CacoEngine::EmitterShape::Cone);
+        trail.Spread = 1.0f;
+        trail.MinSpeed = 20.0f;
+        trail.MaxSpeed = 80.0f;
+        trail.MinLifetime = 1.0f;
+        trail.MaxLifetime = 1.0f;
+        trailEmitter = particleSystem->AddEmitter(trail);
+        
         // Create some attractor points
         for (int i = 0; i < 3; i++) {
             auto attractor = std::make_shared<CacoEngine::Circle>(
@@ -241,11 +138,7 @@ public:
     }
     
     void OnUpdate(double deltaTime) override {
-        // Update particle system
-        particleSystem.Update(deltaTime);
-        
-        // Update visual objects from particle system
-        UpdateParticleVisuals();
+        // The engine updates and draws the particle system itself
         
         // Auto-generate effects
         if (GetTime() - lastAutoEffect > AUTO_EFFECT_INTERVAL) {
@@ -257,24 +150,8 @@ public:
         UpdateDisplay();
     }
     
-    void UpdateParticleVisuals() {
-        // Remove old particle visuals
-        RigidObjects.erase(
-            std::remove_if(RigidObjects.begin(), RigidObjects.end(),
-                [](const std::shared_ptr<CacoEngine::RigidObject2D>& obj) {
-                    return std::dynamic_pointer_cast<Particle>(obj) != nullptr;
-                }),
-            RigidObjects.end()
-        );
-        
-        // Add current particles
-        for (auto& particle : particleSystem.GetParticles()) {
-            RigidObjects.push_back(particle);
-        }
-    }
-    
     void AutoGenerateEffect() {
-        if (particleSystem.GetParticleCount() > 500) return; // Limit particles
+        if (particleSystem->GetCount() > 20000) return; // Limit particles
         
         CacoEngine::Vector2Df position(
             rand() % (int)WINDOW_WIDTH,
@@ -287,22 +164,24 @@ public:
     void CreateEffectAtPosition(CacoEngine::Vector2Df position) {
         switch (currentMode) {
             case EXPLOSIONS:
-                particleSystem.CreateExplosion(position, 30);
+                particleSystem->GetEmitter(explosionEmitter).Position = position;
+                particleSystem->Emit(explosionEmitter, 300);
                 break;
             case FIREWORKS:
-                particleSystem.CreateFirework(position);
+                particleSystem->GetEmitter(fireworkEmitter).Position = position;
+                particleSystem->Emit(fireworkEmitter, 300);
                 break;
             case TRAILS:
                 {
-                    CacoEngine::Vector2Df direction(
-                        (rand() % 200 - 100) / 100.0f,
-                        (rand() % 200 - 100) / 100.0f
-                    );
-                    particleSystem.CreateTrail(position, direction);
+                    CacoEngine::ParticleEmitter& trail = particleSystem->GetEmitter(trailEmitter);
+                    trail.Position = position;
+                    trail.Direction = (rand() % 628) / 100.0f;
+                    particleSystem->Emit(trailEmitter, 100);
                 }
                 break;
             case ATTRACTORS:
-                particleSystem.CreateExplosion(position, 20);
+                particleSystem->GetEmitter(explosionEmitter).Position = position;
+                particleSystem->Emit(explosionEmitter, 200);
                 break;
         }
     }
@@ -312,7 +191,7 @@ public:
         displayCounter++;
         
         if (displayCounter % 60 == 0) {
-            std::cout << "Particles: " << particleSystem.GetParticleCount() << " | Mode: " << GetModeString() << std::endl;
+            std::cout << "Particles: " << particleSystem->GetCount() << " | Mode: " << GetModeString() << std::endl;
         }
     }
     
@@ -349,7 +228,7 @@ public:
                 std::cout << "Mode: Attractors" << std::endl;
                 break;
             case SDLK_SPACE:
-                particleSystem.Clear();
+                particleSystem->Clear();
                 std::cout << "Particles cleared!" << std::endl;
                 break;
             case SDLK_a:
@@ -10,10 +10,12 @@
  * - Food generation and collection
  * - Growing snake mechanics
  * - High score tracking
+ * - Chunked tilemap rendering for the playfield
  */
 
 #include "../include/engine.hpp"
 #include "../include/objects.hpp"
+#include "../include/tilemap.hpp"
 #include <iostream>
 #include <vector>
 #include <deque>
@@ -60,9 +62,12 @@ private:
     // Timing
     double lastMoveTime = 0.0;
     
-    // Visual objects
-    std::vector<std::shared_ptr<CacoEngine::Rectangle>> snakeSegments;
-    std::shared_ptr<CacoEngine::Rectangle> foodRect;
+    // Playfield tiles, only cells that change are touched each move
+    enum Tile : uint16_t {
+        EMPTY = CacoEngine::Tilemap::EmptyTile, HEAD, BODY, FOOD
+    };
+
+    std::shared_ptr<CacoEngine::Tilemap> grid;
     
     // Game settings
     bool speedIncrease = true;
@@ -80,13 +85,26 @@ public:
         std::cout << "Escape - Quit" << std::endl;
         std::cout << "Collect food to grow and increase score!" << std::endl;
         
+        grid = std::make_shared<CacoEngine::Tilemap>(
+            CacoEngine::Vector2D(GRID_WIDTH, GRID_HEIGHT),
+            CacoEngine::Vector2Df(CELL_SIZE, CELL_SIZE)
+        );
+        grid->Gap = 1; // grid lines
+        grid->Palette = {
+            CacoEngine::Colors[(int)CacoEngine::Color::Black], // Empty cells are never drawn
+            CacoEngine::Colors[(int)CacoEngine::Color::Green], // Head is green
+            CacoEngine::Colors[(int)CacoEngine::Color::White], // Body is white
+            CacoEngine::Colors[(int)CacoEngine::Color::Red]
+        };
+        AddDrawable(grid);
+
         InitializeGame();
     }
     
     void InitializeGame() {
-        // Clear existing objects
-        Objects.clear();
-        snakeSegments.clear();
+        // Clear the playfield
+        grid->Fill(EMPTY);
+        foodExists = false;
         
         // Reset game state
         score = 0;
@@ -114,29 +132,12 @@ public:
     }
     
     void CreateSnakeVisuals() {
-        snakeSegments.clear();
-        
         for (size_t i = 0; i < snake.size(); i++) {
-            auto segment = std::make_shared<CacoEngine::Rectangle>(
-                CacoEngine::Vector2Df(snake[i].x * CELL_SIZE, snake[i].y * CELL_SIZE),
-                CacoEngine::Vector2Df(CELL_SIZE - 1, CELL_SIZE - 1), // -1 for grid lines
-                i == 0 ? CacoEngine::Colors[(int)CacoEngine::Color::Green] : // Head is green
-                         CacoEngine::Colors[(int)CacoEngine::Color::White]   // Body is white
-            );
-            snakeSegments.push_back(segment);
-            AddObject(segment);
+            grid->SetTile(snake[i].x, snake[i].y, i == 0 ? HEAD : BODY);
         }
     }
     
     void GenerateFood() {
-        if (foodExists) {
-            // Remove old food
-            auto it = std::find(Objects.begin(), Objects.end(), foodRect);
-            if (it != Objects.end()) {
-                Objects.erase(it);
-            }
-        }
-        
         // Generate food position that's not on snake
         do {
             food.x = rand() % GRID_WIDTH;
@@ -144,12 +145,7 @@ public:
         } while (IsPositionOnSnake(food));
         
         // Create food visual
-        foodRect = std::make_shared<CacoEngine::Rectangle>(
-            CacoEngine::Vector2Df(food.x * CELL_SIZE, food.y * CELL_SIZE),
-            CacoEngine::Vector2Df(CELL_SIZE - 1, CELL_SIZE - 1),
-            CacoEngine::Colors[(int)CacoEngine::Color::Red]
-        );
-        AddObject(foodRect);
+        grid->SetTile(food.x, food.y, FOOD);
         
         foodExists = true;
     }
@@ -203,6 +199,7 @@ public:
         }
         
         // Add new head
+        GridPosition oldHead = snake.front();
         snake.push_front(newHead);
         
         // Check food collision
@@ -218,24 +215,18 @@ public:
             GenerateFood();
         } else {
             // Remove tail if no food eaten
+            grid->SetTile(snake.back().x, snake.back().y, EMPTY);
             snake.pop_back();
         }
         
         // Update visuals
-        UpdateSnakeVisuals();
+        UpdateSnakeVisuals(oldHead);
     }
     
-    void UpdateSnakeVisuals() {
-        // Clear old segments
-        for (auto& segment : snakeSegments) {
-            auto it = std::find(Objects.begin(), Objects.end(), segment);
-            if (it != Objects.end()) {
-                Objects.erase(it);
-            }
-        }
-        
-        // Create new segments
-        CreateSnakeVisuals();
+    void UpdateSnakeVisuals(const GridPosition& oldHead) {
+        // Only the old and new head cells change, the tail was cleared above
+        grid->SetTile(oldHead.x, oldHead.y, BODY);
+        grid->SetTile(snake.front().x, snake.front().y, HEAD);
     }
     
     void GameOver() {
@@ -0,0 +1,42 @@
+#ifndef AABB_H_
+#define AABB_H_
+
+#include "vertex.hpp"
+
+namespace CacoEngine
+{
+    // Axis-aligned bounding box in world coordinates
+    struct AABB
+    {
+        float MinX;
+        float MinY;
+        float MaxX;
+        float MaxY;
+
+        bool Overlaps(const AABB&) const;
+
+        bool Contains(const AABB&) const;
+        bool Contains(Point2Df) const;
+
+        // Smallest box enclosing both
+        AABB Merge(const AABB&) const;
+
+        // Grown by the given margin on every side
+        AABB Expand(float) const;
+
+        Point2Df GetCenter() const;
+
+        // Half the width and height
+        Point2Df GetExtents() const;
+
+        float GetPerimeter() const;
+
+        // Slab test against the segment from the first point to the second. On a hit the
+        // entry point is written as a fraction of the segment, 0 when starting inside.
+        bool IntersectsSegment(Point2Df, Point2Df, float* = nullptr) const;
+
+        AABB(float = 0, float = 0, float = 0, float = 0);
+    };
+}
+
+#endif // AABB_H_
@@ -0,0 +1,95 @@
+#ifndef AABBTREE_H_
+#define AABBTREE_H_
+
+#include <vector>
+#include "broadphase.hpp"
+
+namespace CacoEngine
+{
+    // Bounding volume hierarchy over fattened proxy bounds. Leaves are only reinserted when a
+    // proxy leaves its fat box, and every insertion rebalances the path to the root with tree
+    // rotations. Queries cost O(log n), pair generation O(log n) per proxy that isn't resting,
+    // independent of how unevenly sized the proxies are.
+    class DynamicAABBTree : public Broadphase
+    {
+    protected:
+        static constexpr int NullNode = -1;
+
+        struct Node
+        {
+            // Fattened box for leaves, union of the children otherwise
+            AABB Box;
+
+            // Exact bounds last given for a leaf
+            AABB Tight;
+
+            // Next free node while on the free list
+            int Parent;
+
+            int Left;
+            int Right;
+
+            // 0 for leaves, -1 for free nodes
+            int Height;
+
+            bool IsLeaf() const;
+        };
+
+        std::vector<Node> Nodes;
+
+        int Root;
+
+        int FreeList;
+
+        int ProxyCount;
+
+        float Margin;
+
+        // Traversal stack reused by every query
+        std::vector<int> Stack;
+
+        int AllocateNode();
+        void FreeNode(int);
+
+        void InsertLeaf(int);
+        void RemoveLeaf(int);
+
+        // Rotates the subtree rooted at the node if its children differ in height by more than one,
+        // returns the subtree's new root
+        int Balance(int);
+
+        // Recomputes boxes and heights from the node up to the root, rebalancing on the way
+        void Refit(int);
+
+    public:
+        // The proxy ID is the leaf's node index
+        int CreateProxy(const AABB&) override;
+
+        void DestroyProxy(int) override;
+
+        // Cheap while the new bounds stay inside the leaf's fat box
+        void MoveProxy(int, const AABB&) override;
+
+        void FindPairs(std::vector<BroadphasePair>&) override;
+
+        void QueryRegion(const AABB&, std::vector<int>&) override;
+
+        void QueryRay(Point2Df, Point2Df, std::vector<int>&) override;
+
+        void Clear() override;
+
+        int GetProxyCount() override;
+
+        const AABB& GetFatBounds(int);
+
+        // 0 for a single leaf, -1 when empty
+        int GetHeight();
+
+        // Bounds are grown by the margin on every side when a leaf is (re)inserted
+        DynamicAABBTree(float = 2.0f);
+
+        virtual ~DynamicAABBTree();
+    };
+}
+
+#endif // AABBTREE_H_
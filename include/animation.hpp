@@ -0,0 +1,112 @@
+#ifndef ANIMATION_H_
+#define ANIMATION_H_
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "objects.hpp"
+#include "texture.hpp"
+
+namespace CacoEngine
+{
+    // One texture holding many frames, each frame stored as a precomputed UV rectangle
+    class SpriteSheet
+    {
+    public:
+        Texture SheetTexture;
+
+        // Size of the sheet in pixels
+        Vector2D Size;
+
+        std::vector<TextureRegion> Frames;
+
+        // Adds a frame from a pixel rectangle, returns its index
+        int AddFrame(Vector2D position, Vector2D dimensions);
+
+        // Slices the sheet row-major into equally sized cells, returns the index of the first one added
+        int AddGrid(Vector2D frameSize, int count = -1);
+
+        TextureRegion& GetFrame(int);
+
+        // The size is queried from the texture when not given, which needs the texture to be loaded
+        SpriteSheet(Texture, Vector2D = Vector2D());
+        ~SpriteSheet();
+    };
+
+    // Compact frame table played back over a sheet
+    struct AnimationClip
+    {
+        std::shared_ptr<SpriteSheet> Sheet;
+
+        std::vector<uint16_t> Frames;
+
+        float FrameDuration;
+
+        bool Loop;
+
+        AnimationClip(std::shared_ptr<SpriteSheet> = nullptr, std::vector<uint16_t> = std::vector<uint16_t>(), float = 0.1f, bool = true);
+    };
+
+    // Advances many animators in one batched pass. Animator state is kept in parallel arrays,
+    // and a target's mesh is only touched when its frame actually changes.
+    class AnimationSystem
+    {
+    protected:
+        enum AnimatorFlags : uint8_t
+        {
+            Playing = 1,
+            FlipX = 1 << 1,
+            FlipY = 1 << 2
+        };
+
+        std::vector<AnimationClip> Clips;
+
+        // Dense animator state
+        std::vector<std::shared_ptr<Object>> Targets;
+        std::vector<uint16_t> ClipIndices;
+        std::vector<uint16_t> CurrentFrames;
+        std::vector<float> Times;
+        std::vector<float> Speeds;
+        std::vector<uint8_t> Flags;
+
+        // Stable handles, mapped to and from dense indices so removal can swap-remove
+        std::vector<int> HandleToIndex;
+        std::vector<int> IndexToHandle;
+        std::vector<int> FreeHandles;
+
+        void ApplyFrame(int);
+
+    public:
+        int AddClip(AnimationClip);
+
+        AnimationClip& GetClip(int);
+
+        // Target must use the quad layout produced by Rectangle (Sprite, RigidSprite, Box2D)
+        int AddAnimator(std::shared_ptr<Object>, int clip);
+
+        void RemoveAnimator(int);
+
+        void Play(int, int clip, bool restart = true);
+        void Pause(int);
+        void Resume(int);
+
+        // Mirrors the animator's frames by swapping UVs, no extra texture needed
+        void SetFlip(int, bool x, bool y = false);
+
+        // Negative speeds play backwards; a clip that doesn't loop stops on its first frame
+        void SetSpeed(int, float);
+
+        bool IsPlaying(int);
+
+        int GetFrame(int);
+
+        int GetAnimatorCount();
+
+        void Update(double);
+
+        AnimationSystem();
+        ~AnimationSystem();
+    };
+}
+
+#endif // ANIMATION_H_
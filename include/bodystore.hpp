@@ -0,0 +1,144 @@
+#ifndef BODYSTORE_H_
+#define BODYSTORE_H_
+
+#include <vector>
+#include <cstdint>
+#include "vertex.hpp"
+#include "fixed.hpp"
+#include "threadpool.hpp"
+
+namespace CacoEngine
+{
+    enum class IntegrationScheme : uint8_t
+    {
+        // v += a * dt, then p += v * dt
+        SemiImplicitEuler,
+
+        // p += v * dt + a * dt^2 / 2, then v += a * dt. Forces are gathered once per tick and
+        // held over it, which makes this exact for them where Euler drifts by a * dt^2 / 2.
+        VelocityVerlet
+    };
+
+    // Point bodies stored as structure-of-arrays buffers with precomputed inverse masses,
+    // integrated with SSE/AVX2 kernels over contiguous float lanes. Forces accumulate between
+    // ticks and are cleared by every Integrate.
+    class BodyStore
+    {
+    protected:
+        std::vector<float> PositionX;
+        std::vector<float> PositionY;
+        std::vector<float> VelocityX;
+        std::vector<float> VelocityY;
+        std::vector<float> ForceX;
+        std::vector<float> ForceY;
+
+        // 0 for immovable bodies, which ignore forces and gravity but still move with their velocity
+        std::vector<float> InverseMass;
+
+        int Count;
+
+        void IntegrateEuler(int, int, float);
+        void IntegrateVerlet(int, int, float);
+
+        // Runs the selected scheme over a range of bodies and clears their forces
+        void IntegrateRange(int, int, float);
+
+    public:
+        IntegrationScheme Scheme;
+
+        // Acceleration applied to every movable body
+        Vector2Df Gravity;
+
+        // Returns the new body's index; a mass of 0 or less makes it immovable
+        int Add(Vector2Df, Vector2Df = Vector2Df(), float = 1);
+
+        // Swap-remove, the last body takes over the removed index
+        void Remove(int);
+
+        // Grows or shrinks the store, new bodies are at rest at the origin with a mass of 1
+        void Resize(int);
+
+        void Clear();
+
+        int GetCount();
+
+        Vector2Df GetPosition(int);
+        void SetPosition(int, Vector2Df);
+
+        Vector2Df GetVelocity(int);
+        void SetVelocity(int, Vector2Df);
+
+        float GetInverseMass(int);
+        void SetMass(int, float);
+
+        // Accumulated until the next Integrate
+        void AddForce(int, Vector2Df);
+
+        // Overwrites the accumulated force
+        void SetForce(int, Vector2Df);
+
+        void Integrate(float);
+
+        // Same results, with fixed chunks of bodies spread over the pool
+        void Integrate(float, ThreadPool&);
+
+        BodyStore(int = 0);
+        virtual ~BodyStore();
+    };
+
+    // BodyStore in Q16.16 fixed point, integrated with AVX2/SSE4.1 integer kernels. Every lane
+    // and the scalar tail round the same way, so positions come out bit-identical on any build.
+    class FixedBodyStore
+    {
+    protected:
+        std::vector<int32_t> PositionX;
+        std::vector<int32_t> PositionY;
+        std::vector<int32_t> VelocityX;
+        std::vector<int32_t> VelocityY;
+        std::vector<int32_t> ForceX;
+        std::vector<int32_t> ForceY;
+        std::vector<int32_t> InverseMass;
+
+        int Count;
+
+        void IntegrateEuler(int, int, Fixed);
+        void IntegrateVerlet(int, int, Fixed);
+
+        void IntegrateRange(int, int, Fixed);
+
+    public:
+        IntegrationScheme Scheme;
+
+        FixedVector2 Gravity;
+
+        int Add(FixedVector2, FixedVector2 = FixedVector2(), Fixed = Fixed(1));
+
+        void Remove(int);
+
+        void Resize(int);
+
+        void Clear();
+
+        int GetCount();
+
+        FixedVector2 GetPosition(int);
+        void SetPosition(int, FixedVector2);
+
+        FixedVector2 GetVelocity(int);
+        void SetVelocity(int, FixedVector2);
+
+        Fixed GetInverseMass(int);
+        void SetMass(int, Fixed);
+
+        void AddForce(int, FixedVector2);
+        void SetForce(int, FixedVector2);
+
+        void Integrate(Fixed);
+        void Integrate(Fixed, ThreadPool&);
+
+        FixedBodyStore(int = 0);
+        virtual ~FixedBodyStore();
+    };
+}
+
+#endif // BODYSTORE_H_
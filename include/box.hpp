@@ -11,6 +11,9 @@ namespace CacoEngine
     public:
         Box2D(Vector2Df, Vector2Df, RGBA = Colors[(int)Color::White]);
 
+        // Axis-aligned box over the mesh bounds
+        int AddShape(Narrowphase&) override;
+
         virtual ~Box2D();
     };
 }
@@ -0,0 +1,263 @@
+#ifndef BROADPHASE_H_
+#define BROADPHASE_H_
+
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+#include "aabb.hpp"
+#include "threadpool.hpp"
+
+namespace CacoEngine
+{
+    // Two proxies whose bounds overlap, A < B
+    struct BroadphasePair
+    {
+        int A;
+        int B;
+
+        bool operator ==(const BroadphasePair&) const;
+        bool operator <(const BroadphasePair&) const;
+
+        BroadphasePair(int = 0, int = 0);
+    };
+
+    // Coarse collision pass: tracks one box per proxy and reports which boxes overlap,
+    // so exact shape tests only run on candidate pairs
+    class Broadphase
+    {
+    protected:
+        // Collision filter of every proxy ID that has been given one
+        std::vector<uint32_t> Categories;
+        std::vector<uint32_t> Masks;
+
+        // Indexed by proxy ID, 1 for proxies set resting
+        std::vector<uint8_t> Resting;
+
+        // Live proxies that aren't resting, and the index of each proxy in that list or -1
+        std::vector<int> ActiveProxies;
+        std::vector<int> ActiveSlots;
+
+        // Backends call these as proxies are created and destroyed
+        void AddActive(int);
+        void RemoveActive(int);
+
+    public:
+        // Returns the new proxy's ID; IDs of destroyed proxies are reused.
+        // New proxies are in category 1 and pair with every category.
+        virtual int CreateProxy(const AABB&) = 0;
+
+        virtual void DestroyProxy(int) = 0;
+
+        virtual void MoveProxy(int, const AABB&) = 0;
+
+        // Category bits and the mask of categories the proxy pairs with
+        void SetProxyFilter(int, uint32_t, uint32_t);
+
+        // Each proxy's category is in the other's mask. Checked before the bounds of a candidate
+        // pair, so filtered pairs cost no overlap test and never reach the narrowphase.
+        bool CanPair(int, int) const;
+
+        // A resting proxy is only paired with proxies that aren't, so the searches can skip
+        // everything resting and a mostly resting scene costs in proportion to the rest.
+        // New proxies aren't resting.
+        virtual void SetProxyResting(int, bool);
+
+        bool IsProxyResting(int) const;
+
+        // Replaces the contents with every overlapping pair that isn't two resting proxies,
+        // each reported once
+        virtual void FindPairs(std::vector<BroadphasePair>&) = 0;
+
+        // Same pairs in the same order, with the work spread over the pool where the backend
+        // supports it; the default runs serially
+        virtual void FindPairs(std::vector<BroadphasePair>&, ThreadPool&);
+
+        // Appends every proxy whose bounds overlap the box
+        virtual void QueryRegion(const AABB&, std::vector<int>&) = 0;
+
+        // Appends every proxy whose bounds the segment between the two points crosses
+        virtual void QueryRay(Point2Df, Point2Df, std::vector<int>&) = 0;
+
+        virtual void Clear() = 0;
+
+        virtual int GetProxyCount() = 0;
+
+        virtual ~Broadphase();
+    };
+
+    // Uniform grid hashed into a flat table that is rebuilt every FindPairs with a counting sort.
+    // Cost is linear in the number of proxies as long as most of them span only a few cells.
+    // Resting proxies go into a second table that is kept until one of them changes, and only
+    // the active proxies are looked up in it.
+    class SpatialHashBroadphase : public Broadphase
+    {
+    protected:
+        struct CellEntry
+        {
+            int32_t CellX;
+            int32_t CellY;
+
+            int Proxy;
+        };
+
+        // Proxies covering more cells than this skip the grid and are tested against everyone
+        static constexpr int MaxCellsPerProxy = 64;
+
+        std::vector<AABB> Bounds;
+
+        std::vector<uint8_t> Alive;
+
+        std::vector<int> FreeProxies;
+
+        int ProxyCount;
+
+        float CellSize;
+
+        // Cell size used by the last rebuild
+        float ActiveCellSize;
+
+        // First cell of every proxy, pairs are only reported from the first cell they share
+        std::vector<int32_t> FirstCellX;
+        std::vector<int32_t> FirstCellY;
+
+        // Counting sort storage of the active proxies, BucketStart has one extra slot holding the total
+        std::vector<uint32_t> BucketStart;
+        std::vector<CellEntry> Entries;
+
+        std::vector<int> LargeProxies;
+
+        // Same for the resting proxies, with the ones in the table listed apart from the large ones
+        std::vector<uint32_t> RestingStart;
+        std::vector<CellEntry> RestingEntries;
+        std::vector<int> RestingProxies;
+        std::vector<int> RestingLarge;
+
+        // Set when the resting table no longer matches the resting proxies or the cell size
+        bool RestingDirty;
+
+        // Pair lists of the ranges handed to each chunk in a parallel search
+        std::vector<std::vector<BroadphasePair>> ChunkPairs;
+        std::vector<std::vector<BroadphasePair>> ChunkRestingPairs;
+
+        uint32_t Hash(int32_t, int32_t, uint32_t);
+
+        // Range of cells the bounds cover at the active cell size
+        void GetCells(const AABB&, int32_t&, int32_t&, int32_t&, int32_t&);
+
+        // Fills a table with the listed proxies spanning at most MaxCellsPerProxy cells,
+        // the others go to the large list
+        void BuildTable(const std::vector<int>&, std::vector<uint32_t>&, std::vector<CellEntry>&, std::vector<int>&, std::vector<int>*);
+
+        void Rebuild();
+
+        // Appends the pairs found in the buckets between the two indices
+        void CollectPairs(int, int, std::vector<BroadphasePair>&);
+
+        // Appends the pairs between the active proxies in the given range of ActiveProxies and
+        // the resting proxies in the table
+        void CollectRestingPairs(int, int, std::vector<BroadphasePair>&);
+
+        // Appends the resting proxies in the table the active proxy meets in the cells given
+        void ProbeResting(int, int32_t, int32_t, int32_t, int32_t, std::vector<BroadphasePair>&);
+
+        void CollectLargePairs(std::vector<BroadphasePair>&);
+
+        void TestPair(int, int, std::vector<BroadphasePair>&);
+
+    public:
+        int CreateProxy(const AABB&) override;
+
+        void DestroyProxy(int) override;
+
+        void MoveProxy(int, const AABB&) override;
+
+        void SetProxyResting(int, bool) override;
+
+        void FindPairs(std::vector<BroadphasePair>&) override;
+
+        // Rebuilds serially, then searches ranges of buckets and of active proxies in parallel.
+        // Cells hash to buckets, so each chunk covers a scattered set of grid cells.
+        void FindPairs(std::vector<BroadphasePair>&, ThreadPool&) override;
+
+        void QueryRegion(const AABB&, std::vector<int>&) override;
+
+        void QueryRay(Point2Df, Point2Df, std::vector<int>&) override;
+
+        void Clear() override;
+
+        int GetProxyCount() override;
+
+        // 0 derives the cell size from the average proxy extent, recomputed whenever the
+        // resting table is rebuilt
+        void SetCellSize(float);
+
+        float GetCellSize();
+
+        SpatialHashBroadphase(float = 0);
+
+        virtual ~SpatialHashBroadphase();
+    };
+
+    // Sorted endpoint lists on both axes, repaired by insertion sort on every FindPairs.
+    // Overlapping pairs are kept across calls and only change where endpoints swap,
+    // so scenes that barely move cost little more than a linear pass.
+    class SweepAndPruneBroadphase : public Broadphase
+    {
+    protected:
+        struct Endpoint
+        {
+            float Value;
+
+            // Proxy ID shifted left by one, low bit set for a max endpoint
+            uint32_t Data;
+        };
+
+        std::vector<AABB> Bounds;
+
+        std::vector<uint8_t> Alive;
+
+        std::vector<int> FreeProxies;
+
+        // Destroyed since the last FindPairs, their endpoints are still in the lists
+        std::vector<int> PendingDestroy;
+
+        int ProxyCount;
+
+        std::vector<Endpoint> Endpoints[2];
+
+        // Pair keys, lower ID in the high half
+        std::unordered_set<uint64_t> Overlaps;
+
+        uint64_t Swaps;
+
+        void RemoveDestroyed();
+
+        void SortAxis(int);
+
+    public:
+        int CreateProxy(const AABB&) override;
+
+        void DestroyProxy(int) override;
+
+        void MoveProxy(int, const AABB&) override;
+
+        void FindPairs(std::vector<BroadphasePair>&) override;
+
+        void QueryRegion(const AABB&, std::vector<int>&) override;
+
+        void QueryRay(Point2Df, Point2Df, std::vector<int>&) override;
+
+        void Clear() override;
+
+        int GetProxyCount() override;
+
+        // Endpoint swaps performed by the last FindPairs, the actual work done
+        uint64_t GetSwapCount();
+
+        SweepAndPruneBroadphase();
+
+        virtual ~SweepAndPruneBroadphase();
+    };
+}
+
+#endif // BROADPHASE_H_
@@ -0,0 +1,71 @@
+#ifndef CAMERA_H_
+#define CAMERA_H_
+
+#include <SDL2/SDL.h>
+#include <SDL_rect.h>
+#include "vertex.hpp"
+
+namespace CacoEngine
+{
+    // 2x3 affine world-to-screen matrix: X' = A*X + B*Y + TX, Y' = C*X + D*Y + TY
+    struct CameraTransform
+    {
+        float A, B, C, D;
+
+        float TX, TY;
+
+        bool IsIdentity() const;
+
+        Point2Df Apply(Point2Df) const;
+
+        // Reverses Apply, used to map cursor positions back into the world
+        Point2Df Invert(Point2Df) const;
+
+        bool operator ==(const CameraTransform&) const;
+        bool operator !=(const CameraTransform&) const;
+
+        CameraTransform();
+    };
+
+    // Copies count vertices from the source into the destination, transforming positions.
+    // Source and destination may alias.
+    void TransformVertices(const CameraTransform&, const Vertex2Df*, Vertex2Df*, int);
+
+    // Transforms count points in place
+    void TransformPoints(const CameraTransform&, SDL_FPoint*, int);
+
+    // View into the world with its own region of the window.
+    // Objects keep their world coordinates; the renderer applies the camera while submitting vertices.
+    class Camera
+    {
+    public:
+        // World point shown at the center of the viewport
+        Vector2Df Position;
+
+        // Screen pixels per world unit
+        float Zoom;
+
+        // Radians, counter-clockwise
+        float Rotation;
+
+        // Region of the render output covered by this camera, as fractions in 0..1
+        SDL_FRect Viewport;
+
+        // World-to-viewport transform for a render output of the given size
+        CameraTransform GetTransform(Vector2D) const;
+
+        // Viewport in output pixels
+        SDL_Rect GetViewportRect(Vector2D) const;
+
+        // World space bounding box of everything this camera can see
+        SDL_FRect GetVisibleArea(Vector2D) const;
+
+        // Conversions relative to the whole render output, e.g. for the cursor position
+        Vector2Df WorldToScreen(Vector2Df, Vector2D) const;
+        Vector2Df ScreenToWorld(Vector2Df, Vector2D) const;
+
+        Camera(Vector2Df = Vector2Df(), float = 1, float = 0);
+    };
+}
+
+#endif // CAMERA_H_
@@ -0,0 +1,123 @@
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <string_view>
+#include <cstdio>
+#include <cstdint>
+#include "renderer.hpp"
+
+namespace CacoEngine
+{
+    enum class CaptureFormat
+    {
+        RawRGBA,    // Headerless RGBA8 frames, back to back
+        Y4M         // YUV4MPEG2, 4:2:0 full range
+    };
+
+    struct CaptureStats
+    {
+        uint64_t FramesCaptured;
+
+        uint64_t FramesWritten;
+
+        // No free buffer was available, the writer is behind
+        uint64_t FramesDropped;
+
+        // Skipped on purpose by the frame skip setting
+        uint64_t FramesSkipped;
+
+        uint64_t BytesWritten;
+
+        // Readbacks the capture times cover; frames dropped for lack of a buffer return before one
+        uint64_t FramesTimed;
+
+        // Time the render thread spent in CaptureFrame, in milliseconds
+        double LastCaptureTime;
+        double AverageCaptureTime;
+        double MaxCaptureTime;
+
+        // Time the writer thread spent converting and writing a frame, in milliseconds
+        double AverageWriteTime;
+    };
+
+    // Reads back presented frames into a pool of reusable buffers and streams them to disk
+    // on a background thread. The render thread never waits on I/O; when every buffer is
+    // still queued the frame is dropped and counted instead.
+    class FrameCapture
+    {
+    protected:
+        struct PendingFrame
+        {
+            int Buffer;
+
+            uint64_t Index;
+        };
+
+        std::vector<std::vector<uint8_t>> Buffers;
+
+        std::vector<int> FreeBuffers;
+
+        std::deque<PendingFrame> Pending;
+
+        std::mutex Lock;
+
+        std::condition_variable Signal;
+
+        std::thread Writer;
+
+        FILE* Output;
+
+        bool Running;
+
+        bool Stopping;
+
+        Vector2D FrameSize;
+
+        uint64_t FrameCounter;
+
+        CaptureStats Stats;
+
+        // Writer-thread scratch for the YUV planes
+        std::vector<uint8_t> Planes;
+
+        void WriterLoop();
+
+        size_t WriteFrame(const uint8_t*);
+
+    public:
+        CaptureFormat Format;
+
+        // Captures one frame, then skips this many
+        int FrameSkip;
+
+        // Frame rate recorded in the Y4M header
+        int FrameRate;
+
+        bool Start(std::string_view, CaptureFormat = CaptureFormat::Y4M, int frameSkip = 0, int bufferCount = 4, int frameRate = 60);
+
+        // Writes out every queued frame and closes the file
+        void Stop();
+
+        bool IsRunning();
+
+        // Call once per frame after everything is drawn and before SDL_RenderPresent
+        void CaptureFrame(Renderer&);
+
+        CaptureStats GetStats();
+
+        FrameCapture();
+        FrameCapture(const FrameCapture&) = delete;
+
+        FrameCapture& operator =(const FrameCapture&) = delete;
+
+        ~FrameCapture();
+    };
+}
+
+#endif // CAPTURE_H_
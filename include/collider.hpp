@@ -2,14 +2,19 @@
 #define COLLIDER_H_
 
 #include <functional>
+#include <memory>
+#include <iostream>
 #include "rigidobject.hpp"
+#include "physicsworld.hpp"
 
 namespace CacoEngine
 {
     template<typename T>
     using ColliderCallback = std::function<bool(std::shared_ptr<RigidObject2D>)>; //  bool(*)(T, T);
 
-    // Wrapper for collision check and resolution routines
+    // Wrapper for collision check and resolution routines.
+    // Keep one alive across frames: it refers to the object list rather than copying it,
+    // and its world keeps the broadphase state between calls to Handle().
     template<typename T>
     class Collider
     {
@@ -18,15 +23,29 @@ namespace CacoEngine
 
         std::vector<T> Objects;
 
-        std::vector<std::shared_ptr<RigidObject2D>> mObjects;
+        std::vector<std::shared_ptr<RigidObject2D>>& mObjects;
+
+        PhysicsWorld World;
 
     public:
+        // Only pairs reported by the broadphase reach the narrowphase. The callback runs once for
+        // each object of a pair when they start touching; GetEvents has the full begin/stay/end
+        // stream for the tick.
         virtual void Handle()
         {
-            for (int x = 0; x < this->mObjects.size(); x++)
-                for (int y = 0; y < this->mObjects.size(); y++)
-                    if (x != y && this->mObjects[x]->CollidesWith(*this->mObjects[y]))
-                        this->Callback(this->mObjects[y]);
+            this->World.UpdateContacts(this->mObjects);
+
+            if (!this->Callback)
+                return;
+
+            const std::vector<ContactEvent>& events = this->World.GetContactEvents();
+
+            for (int x = 0; x < events.size(); x++)
+                if (events[x].Type == ContactEventType::Begin)
+                {
+                    this->Callback(this->mObjects[events[x].B]);
+                    this->Callback(this->mObjects[events[x].A]);
+                }
         }
 
         void AddObject(T object)
@@ -45,11 +64,23 @@ namespace CacoEngine
             return this->Objects;
         }
 
-        std::vector<std::shared_ptr<RigidObject2D>> GetmObjects()
+        std::vector<std::shared_ptr<RigidObject2D>>& GetmObjects()
         {
             return this->mObjects;
         }
 
+        // Contact events written by the last Handle()
+        const std::vector<ContactEvent>& GetEvents()
+        {
+            return this->World.GetContactEvents();
+        }
+
+        // Selects the broadphase backend, see PhysicsWorld::SetBroadphase
+        PhysicsWorld& GetWorld()
+        {
+            return this->World;
+        }
+
         Collider(std::vector<T> objects, std::vector<std::shared_ptr<RigidObject2D>>& mObjects, ColliderCallback<T> callback = nullptr) : Callback(callback), Objects(objects), mObjects(mObjects)
         {
         }
@@ -65,16 +96,27 @@ namespace CacoEngine
 
     public:
 
+        // Reports circles that start touching; other object types are skipped
         void Handle()
         {
-            for (int x = 0; x < this->Objects.size(); x++)
-                for (int y = 0; y < this->Objects.size(); y++)
-                    if (x != y && this->Objects[x].CollidesWith(this->Objects[y]))
-                    {
-                        this->Callback(this->mObjects[y]);
-
-                        std::cout << "Collides\n";
-                    }
+            this->World.UpdateContacts(this->mObjects);
+
+            const std::vector<ContactEvent>& events = this->World.GetContactEvents();
+
+            for (int x = 0; x < events.size(); x++)
+            {
+                if (events[x].Type != ContactEventType::Begin)
+                    continue;
+
+                std::shared_ptr<RigidObject2D>& first = this->mObjects[events[x].A];
+                std::shared_ptr<RigidObject2D>& second = this->mObjects[events[x].B];
+
+                if (dynamic_cast<RigidCircle*>(first.get()) && dynamic_cast<RigidCircle*>(second.get()))
+                {
+                    this->Callback(second);
+                    this->Callback(first);
+                }
+            }
         }
 
 
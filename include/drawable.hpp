@@ -0,0 +1,23 @@
+#ifndef DRAWABLE_H_
+#define DRAWABLE_H_
+
+#include "renderer.hpp"
+
+namespace CacoEngine
+{
+    // Base for engine-managed render subsystems that aren't a single Object (layers, maps, particles)
+    class Drawable
+    {
+    public:
+        bool Visible;
+
+        virtual void Update(double);
+        virtual void Draw(Renderer&) = 0;
+
+        Drawable();
+
+        virtual ~Drawable();
+    };
+}
+
+#endif // DRAWABLE_H_
@@ -0,0 +1,85 @@
+#ifndef DYNAMICRESOLUTION_H_
+#define DYNAMICRESOLUTION_H_
+
+#include <SDL2/SDL.h>
+#include <SDL_render.h>
+#include "renderer.hpp"
+
+namespace CacoEngine
+{
+    // Renders the frame into an offscreen target at a fraction of the window resolution and
+    // upscales it on present. The fraction follows the measured frame time: it drops when frames
+    // run over budget and recovers once they are comfortably under it again.
+    class DynamicResolution
+    {
+    protected:
+        SDL_Texture* Target;
+
+        Vector2D TargetSize;
+
+        // Scale in use for the frame in progress
+        float Scale;
+
+        // Target is bound for the current frame
+        bool Active;
+
+        // Exponential moving average of the frame time, in seconds
+        double SmoothedFrameTime;
+
+        // Consecutive frames spent above or below the thresholds
+        int OverBudgetFrames;
+        int UnderBudgetFrames;
+
+        // Frames left before the scale may change again
+        int Cooldown;
+
+    public:
+        bool Enabled;
+
+        // Frame time budget in seconds, 1/60 by default
+        double TargetFrameTime;
+
+        float MinScale;
+        float MaxScale;
+
+        // Scale change per adjustment
+        float Step;
+
+        // Scale down above Budget * OverBudgetRatio, scale up below Budget * UnderBudgetRatio.
+        // The gap between the two keeps the scale from oscillating.
+        double OverBudgetRatio;
+        double UnderBudgetRatio;
+
+        // Frames a condition has to persist before acting; recovering is slower than backing off
+        int DownscaleDelay;
+        int UpscaleDelay;
+
+        // Frames to wait after any change so its effect shows up in the average
+        int CooldownFrames;
+
+        // Binds the offscreen target and scale, call before clearing the frame
+        void Begin(Renderer&);
+
+        // Restores the window as the target and upscales the rendered region onto it
+        void End(Renderer&);
+
+        // Feeds the controller with the duration of the last frame, in seconds
+        void Update(double);
+
+        float GetScale();
+
+        double GetSmoothedFrameTime();
+
+        // Forces a scale, clamped to MinScale..MaxScale; the controller carries on from it after the cooldown
+        void SetScale(float);
+
+        DynamicResolution();
+        DynamicResolution(const DynamicResolution&) = delete;
+
+        DynamicResolution& operator =(const DynamicResolution&) = delete;
+
+        ~DynamicResolution();
+    };
+}
+
+#endif // DYNAMICRESOLUTION_H_
@@ -12,6 +12,12 @@
 #include "surface.hpp"
 #include "renderer.hpp"
 #include "rigidobject.hpp"
+#include "physicsworld.hpp"
+#include "drawable.hpp"
+#include "capture.hpp"
+#include "textureloader.hpp"
+#include "camera.hpp"
+#include "dynamicresolution.hpp"
 #include "key.hpp"
 
 namespace CacoEngine
@@ -36,6 +42,15 @@ namespace CacoEngine
 
             Surface WindowSurface;
 
+            // Optional recording of every presented frame, see FrameCapture::Start
+            FrameCapture Capture;
+
+            // Decodes images in the background, finished ones are uploaded at the start of each frame
+            TextureLoader AsyncTextures;
+
+            // Optional reduced resolution rendering under load, off until Enabled is set
+            DynamicResolution ResolutionScaling;
+
             uint8_t* KeyStates;
 
             std::unordered_map<SDL_Keycode, Key> KeyMap;
@@ -44,6 +59,15 @@ namespace CacoEngine
 
             std::vector<std::shared_ptr<RigidObject2D>> RigidObjects;
 
+            // Steps RigidObjects once per frame on every hardware thread
+            PhysicsWorld World;
+
+            // Layers and other subsystems, drawn in insertion order before Objects
+            std::vector<std::shared_ptr<Drawable>> Drawables;
+
+            // The scene is drawn once per camera into its viewport; with none, in screen coordinates
+            std::vector<std::shared_ptr<Camera>> Cameras;
+
             bool HasExtension(Extension);
 
             void UpdatePhysics();
@@ -54,6 +78,13 @@ namespace CacoEngine
 
             void Render(SDL_Renderer*, std::vector<std::shared_ptr<Object>>&);
             void Render(SDL_Renderer*, std::vector<std::shared_ptr<RigidObject2D>>&);
+            void Render(SDL_Renderer*, std::vector<std::shared_ptr<Drawable>>&);
+
+            void RenderScene(SDL_Renderer*);
+
+            void UpdateDrawables();
+
+            void Present();
 
     public:
             std::string_view Title;
@@ -75,6 +106,15 @@ namespace CacoEngine
 
             Key GetKeyState(SDL_Scancode);
 
+            // Per-frame statistics live on the renderer, see Renderer::GetAverageStats
+            Renderer& GetRenderer();
+
+            // Contact resolution and thread count are configured here, see PhysicsWorld
+            PhysicsWorld& GetWorld();
+
+            // Per-frame upload time is set with TextureLoader::UploadBudget
+            TextureLoader& GetTextureLoader();
+
             /** Event handlers **/
             virtual void OnKeyPress(SDL_KeyboardEvent&) = 0;
             virtual void OnMouseClick(SDL_MouseButtonEvent&) = 0;
@@ -86,6 +126,12 @@ namespace CacoEngine
             Object& AddObject(std::shared_ptr<Object>);
             RigidObject2D& AddObject(std::shared_ptr<RigidObject2D>);
 
+            Drawable& AddDrawable(std::shared_ptr<Drawable>);
+
+            Camera& AddCamera(std::shared_ptr<Camera>);
+
+            bool RemoveCamera(const std::shared_ptr<Camera>&);
+
             Object& CreateMesh(std::vector<Vector2Df>);
             
             Engine(std::string_view = "CacoEngine App", Vector2Df = Vector2Df(800, 600), bool = true);
@@ -0,0 +1,103 @@
+#ifndef FIXED_H_
+#define FIXED_H_
+
+#include <cstdint>
+
+namespace CacoEngine
+{
+    // Q16.16 fixed-point number: 16 integer bits including the sign, 16 fraction bits, range
+    // about +-32768 in steps of 1/65536. Every operation is integer arithmetic with fixed rounding,
+    // so results are identical on any compiler, flag set and CPU. Overflow wraps.
+    // The basic operators are defined here so they inline into the physics kernels.
+    struct Fixed
+    {
+        int32_t Raw;
+
+        static constexpr int FractionBits = 16;
+        static constexpr int32_t One = 1 << FractionBits;
+
+        constexpr Fixed() : Raw(0) {}
+        explicit constexpr Fixed(int value) : Raw((int32_t)((uint32_t)value << FractionBits)) {}
+
+        static constexpr Fixed FromRaw(int32_t raw)
+        {
+            Fixed value;
+            value.Raw = raw;
+            return value;
+        }
+
+        // Rounds to the nearest step. Exact for values already on the grid, which makes
+        // storing fixed results in doubles and reading them back lossless.
+        static Fixed FromDouble(double);
+
+        double ToDouble() const { return this->Raw / (double)One; }
+        float ToFloat() const { return this->Raw / (float)One; }
+
+        Fixed operator +(Fixed rhs) const { return FromRaw((int32_t)((uint32_t)this->Raw + (uint32_t)rhs.Raw)); }
+        Fixed operator -(Fixed rhs) const { return FromRaw((int32_t)((uint32_t)this->Raw - (uint32_t)rhs.Raw)); }
+        Fixed operator -() const { return FromRaw((int32_t)(0u - (uint32_t)this->Raw)); }
+
+        // Rounds towards negative infinity
+        Fixed operator *(Fixed rhs) const { return FromRaw((int32_t)(((int64_t)this->Raw * rhs.Raw) >> FractionBits)); }
+
+        // Truncates towards zero, division by zero saturates
+        Fixed operator /(Fixed) const;
+
+        Fixed& operator +=(Fixed rhs) { return *this = *this + rhs; }
+        Fixed& operator -=(Fixed rhs) { return *this = *this - rhs; }
+        Fixed& operator *=(Fixed rhs) { return *this = *this * rhs; }
+        Fixed& operator /=(Fixed rhs) { return *this = *this / rhs; }
+
+        bool operator ==(Fixed rhs) const { return this->Raw == rhs.Raw; }
+        bool operator !=(Fixed rhs) const { return this->Raw != rhs.Raw; }
+        bool operator <(Fixed rhs) const { return this->Raw < rhs.Raw; }
+        bool operator <=(Fixed rhs) const { return this->Raw <= rhs.Raw; }
+        bool operator >(Fixed rhs) const { return this->Raw > rhs.Raw; }
+        bool operator >=(Fixed rhs) const { return this->Raw >= rhs.Raw; }
+
+        static Fixed Abs(Fixed value) { return (value.Raw < 0) ? -value : value; }
+        static Fixed Min(Fixed a, Fixed b) { return (a < b) ? a : b; }
+        static Fixed Max(Fixed a, Fixed b) { return (a > b) ? a : b; }
+
+        // Exact integer square root rounded down, 0 for negative values
+        static Fixed Sqrt(Fixed);
+
+        // Length of the vector, squared in 64 bits so it doesn't overflow before the root
+        static Fixed Hypot(Fixed, Fixed);
+
+        // Radians, read from a quarter sine table with linear interpolation, error below 2e-4
+        static Fixed Sin(Fixed);
+        static Fixed Cos(Fixed);
+
+        static const Fixed Pi;
+    };
+
+    struct FixedVector2
+    {
+        Fixed X;
+        Fixed Y;
+
+        FixedVector2(Fixed x = Fixed(), Fixed y = Fixed()) : X(x), Y(y) {}
+
+        FixedVector2 operator +(FixedVector2 rhs) const { return FixedVector2(this->X + rhs.X, this->Y + rhs.Y); }
+        FixedVector2 operator -(FixedVector2 rhs) const { return FixedVector2(this->X - rhs.X, this->Y - rhs.Y); }
+        FixedVector2 operator *(Fixed rhs) const { return FixedVector2(this->X * rhs, this->Y * rhs); }
+
+        Fixed Dot(FixedVector2 rhs) const { return this->X * rhs.X + this->Y * rhs.Y; }
+
+        Fixed Length() const { return Fixed::Hypot(this->X, this->Y); }
+    };
+
+    struct FixedAABB
+    {
+        Fixed MinX;
+        Fixed MinY;
+        Fixed MaxX;
+        Fixed MaxY;
+
+        FixedAABB(Fixed minX = Fixed(), Fixed minY = Fixed(), Fixed maxX = Fixed(), Fixed maxY = Fixed())
+            : MinX(minX), MinY(minY), MaxX(maxX), MaxY(maxY) {}
+    };
+}
+
+#endif // FIXED_H_
@@ -0,0 +1,82 @@
+#ifndef LAYER_H_
+#define LAYER_H_
+
+#include <SDL2/SDL.h>
+#include <SDL_render.h>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include "drawable.hpp"
+#include "objects.hpp"
+#include "camera.hpp"
+
+namespace CacoEngine
+{
+    // Group of objects rendered once into a render-target texture and composited as a single quad.
+    // The texture covers the members' world bounds and is drawn through the active camera, so
+    // panning and rotating reuse it. One texture is kept per camera zoom, so cameras at different
+    // zooms don't re-render each other's; all of them are rebuilt when a member is added or
+    // removed, or after Invalidate().
+    class Layer : public Drawable
+    {
+    protected:
+        struct Target
+        {
+            SDL_Texture* Texture;
+
+            Vector2D Size;
+
+            // World rectangle the texture covers
+            SDL_FRect Bounds;
+
+            bool Stale;
+
+            uint64_t LastUsed;
+        };
+
+        // Zooms with a cached texture at once, the least recently drawn one is given up past this
+        static constexpr int MaxTargets = 4;
+
+        std::vector<std::shared_ptr<Object>> Objects;
+
+        // Keyed by camera zoom, texels per world unit before clamping to the renderer's maximum texture size
+        std::unordered_map<float, Target> Targets;
+
+        uint64_t DrawCount;
+
+        bool Dirty;
+
+        Target& GetTarget(float);
+
+        void Rebuild(Renderer&, Target&, float);
+
+    public:
+        // Color the target is cleared to before the members are drawn; transparent by default
+        RGBA ClearColor;
+
+        Object& AddObject(std::shared_ptr<Object>);
+
+        bool RemoveObject(const std::shared_ptr<Object>&);
+
+        void Clear();
+
+        // Marks the cached texture stale, call after modifying a member in place
+        void Invalidate();
+
+        bool IsDirty();
+
+        std::vector<std::shared_ptr<Object>>& GetObjects();
+
+        void Draw(Renderer&) override;
+
+        Layer();
+        Layer(const Layer&) = delete;
+
+        Layer& operator =(const Layer&) = delete;
+
+        virtual ~Layer();
+    };
+}
+
+#endif // LAYER_H_
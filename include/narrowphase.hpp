@@ -0,0 +1,212 @@
+#ifndef NARROWPHASE_H_
+#define NARROWPHASE_H_
+
+#include <vector>
+#include <cstdint>
+#include "aabb.hpp"
+#include "fixed.hpp"
+#include "broadphase.hpp"
+#include "threadpool.hpp"
+
+namespace CacoEngine
+{
+    enum class ShapeType : uint8_t
+    {
+        Circle,
+        Box,
+        OrientedBox,
+        Polygon,
+        Count
+    };
+
+    // Touching pair of shapes. Normal points from A to B; moving B along it by Depth separates them.
+    struct Contact
+    {
+        int A;
+        int B;
+
+        Point2Df Normal;
+
+        // Penetration depth, always positive
+        float Depth;
+
+        // Midway between the two surfaces
+        Point2Df Point;
+
+        Contact(int = 0, int = 0, Point2Df = Point2Df(), float = 0, Point2Df = Point2Df());
+    };
+
+    // Exact collision pass over broadphase candidates. Shapes are stored in compact per-type
+    // arrays and candidate pairs are bucketed by type combination, so each bucket runs one
+    // kernel without virtual calls. Circle and box buckets are tested 8 (AVX2) or 4 (SSE2)
+    // pairs at a time; oriented boxes and convex polygons go through the separating axis test.
+    class Narrowphase
+    {
+    protected:
+        struct ShapeRef
+        {
+            ShapeType Type;
+
+            // Index into the type's arrays
+            int Index;
+        };
+
+        struct OrientedBox
+        {
+            Point2Df Center;
+
+            // Half the width and height
+            Point2Df Extents;
+
+            // Cosine and sine of the rotation
+            Point2Df Axis;
+        };
+
+        struct Polygon
+        {
+            int First;
+            int Count;
+        };
+
+        // Boxes and oriented boxes are expanded into this form for the separating axis test
+        struct PolygonView
+        {
+            const Point2Df* Vertices;
+            const Point2Df* Normals;
+
+            int Count;
+        };
+
+        // Pair taken from a bucket, A holds the shape with the lower type
+        struct BatchPair
+        {
+            int A;
+            int B;
+
+            // A and B were exchanged to order the types, the contact is flipped back on output
+            bool Swapped;
+        };
+
+        std::vector<ShapeRef> Shapes;
+
+        std::vector<float> CircleX;
+        std::vector<float> CircleY;
+        std::vector<float> CircleRadius;
+
+        std::vector<float> BoxMinX;
+        std::vector<float> BoxMinY;
+        std::vector<float> BoxMaxX;
+        std::vector<float> BoxMaxY;
+
+        std::vector<OrientedBox> OrientedBoxes;
+
+        // Convex hulls with outward edge normals, edge i runs from vertex i to vertex i + 1
+        std::vector<Polygon> Polygons;
+        std::vector<Point2Df> PolygonVertices;
+        std::vector<Point2Df> PolygonNormals;
+
+        // Hull construction storage, kept to avoid allocating per polygon
+        std::vector<Point2Df> SortedPoints;
+        std::vector<Point2Df> HullPoints;
+
+        // Scratch for one thread running the kernels
+        struct Workspace
+        {
+            std::vector<BatchPair> Buckets[(int)ShapeType::Count * (int)ShapeType::Count];
+
+            // Per-lane inputs gathered from the shape arrays, then kernel outputs
+            std::vector<float> LaneA[4];
+            std::vector<float> LaneB[4];
+            std::vector<float> LaneDepth;
+            std::vector<float> LaneNormalX;
+            std::vector<float> LaneNormalY;
+            std::vector<float> LanePointX;
+            std::vector<float> LanePointY;
+        };
+
+        // One per pool thread, the first also serves serial calls
+        std::vector<Workspace> Workspaces;
+
+        // Contacts of each chunk in a parallel pass, joined in chunk order
+        std::vector<std::vector<Contact>> ChunkContacts;
+
+        PolygonView GetPolygon(int, Point2Df*, Point2Df*);
+
+        void GatherCircles(const std::vector<BatchPair>&, std::vector<float>*, bool);
+        void GatherBoxes(const std::vector<BatchPair>&, std::vector<float>*, bool);
+
+        void ResizeLanes(Workspace&, int);
+
+        // Writes the lanes with a positive depth out as contacts
+        void EmitLanes(const std::vector<BatchPair>&, std::vector<Contact>&, Workspace&);
+
+        void CollideCircles(const std::vector<BatchPair>&, std::vector<Contact>&, Workspace&);
+        void CollideCircleBoxes(const std::vector<BatchPair>&, std::vector<Contact>&, Workspace&);
+        void CollideBoxes(const std::vector<BatchPair>&, std::vector<Contact>&, Workspace&);
+
+        // Scalar test of any type combination, the contact is oriented from the bucket's A to B
+        bool CollidePair(const BatchPair&, Contact&);
+
+        // Any remaining combination, circles against polygons or polygons against polygons
+        void CollideGeneric(const std::vector<BatchPair>&, std::vector<Contact>&);
+
+        // Buckets and tests a run of pairs, appending the contacts
+        void CollideRange(const BroadphasePair*, int, std::vector<Contact>&, Workspace&);
+
+    public:
+        // Each Add returns the shape ID, assigned in order from 0 after every Clear
+        int AddCircle(Point2Df, float);
+        int AddBox(const AABB&);
+
+        // Center, half extents and rotation in radians
+        int AddOrientedBox(Point2Df, Point2Df, float);
+
+        // Takes the convex hull of the points, fewer than three distinct points become a box.
+        // The stride in bytes lets the points be read straight out of mesh vertices.
+        int AddPolygon(const Point2Df*, int, int = sizeof(Point2Df));
+
+        void Clear();
+
+        int GetShapeCount();
+
+        ShapeType GetShapeType(int);
+
+        // Replaces the contents with a contact for every pair of shape IDs that touches.
+        // Contacts are grouped by type combination rather than kept in input order.
+        void Collide(const std::vector<BroadphasePair>&, std::vector<Contact>&);
+
+        // Splits the pairs into fixed-size chunks tested in parallel. The output is the same for
+        // any thread count, though grouped per chunk rather than as a serial Collide would.
+        void Collide(const std::vector<BroadphasePair>&, std::vector<Contact>&, ThreadPool&);
+
+        // Tests a single pair of shape IDs
+        bool Test(int, int, Contact* = nullptr);
+
+        // Scalar tests, also used for the lanes left over after the SIMD kernels
+        static bool TestCircles(Point2Df, float, Point2Df, float, Contact* = nullptr);
+        static bool TestCircleBox(Point2Df, float, const AABB&, Contact* = nullptr);
+        static bool TestBoxes(const AABB&, const AABB&, Contact* = nullptr);
+
+        // The same tests in Q16.16, bit-identical on every build. The contact is written as floats,
+        // which hold the normal and any depth below 256 exactly.
+        static bool TestCircles(FixedVector2, Fixed, FixedVector2, Fixed, Contact* = nullptr);
+        static bool TestCircleBox(FixedVector2, Fixed, const FixedAABB&, Contact* = nullptr);
+        static bool TestBoxes(const FixedAABB&, const FixedAABB&, Contact* = nullptr);
+
+        // Time of impact of a shape moving in a straight line against a resting one, written as
+        // a fraction of the motion, and the normal of the surface hit pointing from the moving
+        // shape to the other. False when they never touch or already overlap at the start,
+        // which is left to the regular tests.
+        static bool SweepCircles(Point2Df, Point2Df, float, Point2Df, float, float* = nullptr, Point2Df* = nullptr);
+        static bool SweepCircleBox(Point2Df, Point2Df, float, const AABB&, float* = nullptr, Point2Df* = nullptr);
+
+        // The first box moves by the offset
+        static bool SweepBoxes(const AABB&, Point2Df, const AABB&, float* = nullptr, Point2Df* = nullptr);
+
+        Narrowphase();
+
+        virtual ~Narrowphase();
+    };
+}
+
+#endif // NARROWPHASE_H_
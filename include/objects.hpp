@@ -28,6 +28,10 @@ namespace CacoEngine
 
         void AddTriangle(Vertex2Df, Vertex2Df, Vertex2Df);
 
+        // Remaps the UVs of a two-triangle quad built by Rectangle onto a texture region,
+        // optionally mirrored. Meshes with any other layout are left untouched.
+        void SetQuadRegion(TextureRegion, bool = false, bool = false);
+
         std::vector<SDL_Vertex> GetVertexBuffer();
 
         std::vector<SDL_FPoint> GetPoints();
@@ -0,0 +1,121 @@
+#ifndef PARTICLES_H_
+#define PARTICLES_H_
+
+#include <vector>
+#include <random>
+#include <cstdint>
+#include "drawable.hpp"
+#include "texture.hpp"
+#include "vertex.hpp"
+
+namespace CacoEngine
+{
+    enum class EmitterShape
+    {
+        Point,      // All particles start at Position, any direction
+        Circle,     // Inside a disk of radius Extents.X, any direction
+        Ring,       // On a circle of radius Extents.X, moving outward
+        Rectangle,  // Inside a box of half size Extents, any direction
+        Cone        // At Position, within Spread radians around Direction
+    };
+
+    struct ParticleEmitter
+    {
+        EmitterShape Shape;
+
+        Vector2Df Position;
+
+        Vector2Df Extents;
+
+        // Cone axis and full opening angle, in radians
+        float Direction;
+        float Spread;
+
+        float MinSpeed;
+        float MaxSpeed;
+
+        float MinLifetime;
+        float MaxLifetime;
+
+        // A color is picked at random per particle; white when empty
+        std::vector<RGBA> Palette;
+
+        // Continuous emission in particles per second, 0 for bursts only
+        float Rate;
+
+        float Accumulator;
+
+        bool Enabled;
+
+        ParticleEmitter(EmitterShape = EmitterShape::Point, Vector2Df = Vector2Df());
+    };
+
+    // Particles stored as structure-of-arrays buffers, integrated with SSE/AVX2 kernels,
+    // compacted by swap-remove and drawn as one indexed quad batch.
+    class ParticleSystem : public Drawable
+    {
+    protected:
+        std::vector<float> PositionX;
+        std::vector<float> PositionY;
+        std::vector<float> VelocityX;
+        std::vector<float> VelocityY;
+        std::vector<float> Life;
+        std::vector<float> InverseLifetime;
+        std::vector<Color32> BaseColors;
+
+        int Count;
+
+        int Capacity;
+
+        std::vector<ParticleEmitter> Emitters;
+
+        // Persistent draw buffers, only grow
+        std::vector<Vertex2Df> Vertices;
+        std::vector<int> Indices;
+
+        std::mt19937 Generator;
+
+        void Integrate(float);
+
+        void Compact();
+
+        void Spawn(ParticleEmitter&);
+
+        float RandomRange(float, float);
+
+    public:
+        Vector2Df Gravity;
+
+        // Fraction of velocity lost per second
+        float Drag;
+
+        // Edge length of each particle quad in pixels
+        float ParticleSize;
+
+        // Optional sprite, particles are solid quads without one
+        Texture ParticleTexture;
+
+        int AddEmitter(ParticleEmitter);
+
+        ParticleEmitter& GetEmitter(int);
+
+        // Spawns a burst from an emitter regardless of its rate
+        void Emit(int, int);
+
+        // Spawns a single particle, returns false when the system is full
+        bool Emit(Vector2Df, Vector2Df, float, RGBA = Colors[(int)Color::White]);
+
+        void Clear();
+
+        int GetCount();
+        int GetCapacity();
+
+        void Update(double) override;
+        void Draw(Renderer&) override;
+
+        ParticleSystem(int = 10000);
+        virtual ~ParticleSystem();
+    };
+}
+
+#endif // PARTICLES_H_
@@ -0,0 +1,470 @@
+#ifndef PHYSICSWORLD_H_
+#define PHYSICSWORLD_H_
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+#include "rigidobject.hpp"
+#include "broadphase.hpp"
+#include "narrowphase.hpp"
+#include "bodystore.hpp"
+
+namespace CacoEngine
+{
+    // Two objects whose bounds overlap, as indices into the object list last given to the world
+    struct BodyPair
+    {
+        int A;
+        int B;
+
+        BodyPair(int = 0, int = 0);
+    };
+
+    enum class ContactEventType : uint8_t
+    {
+        // First tick the pair touches
+        Begin,
+
+        // Touching this tick and the last
+        Stay,
+
+        // Touched last tick but not this one
+        End
+    };
+
+    struct ContactEvent
+    {
+        ContactEventType Type;
+
+        // Object indices as in Contact; -1 on an End event for an object that left the list
+        int A;
+        int B;
+
+        // Copied from the contact, zero on End events
+        Point2Df Normal;
+        float Depth;
+        Point2Df Point;
+
+        ContactEvent(ContactEventType = ContactEventType::Begin, int = -1, int = -1, Point2Df = Point2Df(), float = 0, Point2Df = Point2Df());
+    };
+
+    struct RaycastHit
+    {
+        RigidObject2D* Object;
+
+        Vector2Df Point;
+
+        Vector2Df Normal;
+
+        // Position of the hit along the ray, 0 at the start and 1 at the end
+        float Fraction;
+
+        RaycastHit();
+    };
+
+    // Keeps a broadphase in sync with a list of rigid objects across ticks.
+    // Objects are matched to their proxies by physics ID, so the list may be reordered,
+    // grown or shrunk between calls; proxies of objects no longer present are released.
+    class PhysicsWorld
+    {
+    protected:
+        std::unique_ptr<Broadphase> Phase;
+
+        // Keyed by the objects' physics IDs
+        std::unordered_map<uint64_t, int> Proxies;
+
+        // Indexed by proxy ID. Owners may already be freed when they leave the list, so their
+        // physics IDs are kept alongside to release the proxy.
+        std::vector<RigidObject2D*> ProxyOwners;
+        std::vector<uint64_t> ProxyObjectIDs;
+        std::vector<int> ProxyIndex;
+        std::vector<uint64_t> ProxyStamp;
+
+        // What the owner was at the last sync, and the filter it had, so unchanged objects cost
+        // no broadphase calls
+        enum ProxyStates : uint8_t
+        {
+            ProxyMoving,
+            ProxyImmovable,
+            ProxySleeping,
+            ProxyNew
+        };
+
+        std::vector<uint8_t> ProxyState;
+        std::vector<uint32_t> ProxyCategory;
+        std::vector<uint32_t> ProxyMask;
+
+        // Set by SetLayerCollision, every proxy's filter is refreshed on the next sync
+        bool FiltersChanged;
+
+        uint64_t Stamp;
+
+        // Awake and immovable objects at the last sync, the only ones whose bounds are gathered
+        std::vector<int> SyncObjects;
+
+        std::vector<BroadphasePair> ProxyPairs;
+
+        std::vector<BodyPair> Pairs;
+
+        std::vector<int> QueryResults;
+
+        Narrowphase Shapes;
+
+        // Shape ID of every object index this tick, -1 until a pair needs it; and the reverse
+        std::vector<int> ObjectShapes;
+        std::vector<int> ShapeObjects;
+
+        std::vector<BroadphasePair> ShapePairs;
+
+        std::vector<Contact> Contacts;
+
+        // Proxy ID of every object index, filled by SyncProxies
+        std::vector<int> ObjectProxies;
+
+        // Touching pairs keyed by proxy IDs, lower ID in the high half. Proxy IDs stay fixed
+        // while an object is in the list, and one freed by a removal is only handed out again
+        // after the pair's End event has been written.
+        std::unordered_set<uint64_t> ActivePairs;
+        std::unordered_set<uint64_t> CurrentPairs;
+
+        // Touching pairs set aside while both ends rest, as the other proxy of each, per proxy.
+        // They go back to ActivePairs once either end changes state or leaves, which keeps
+        // resting piles out of the per-step event pass.
+        std::vector<std::vector<int>> RestingPartners;
+
+        void SetPairResting(int, int);
+
+        // Moves the proxy's resting pairs back to ActivePairs
+        void ReleaseRestingPairs(int);
+
+        std::vector<ContactEvent> Events;
+
+        // Begin and End events of the substeps before the last in a Step
+        std::vector<ContactEvent> SubstepEvents;
+
+        int SubstepCount;
+
+        // Deepest contact of the last Step, drives adaptive substepping
+        float DeepestContact;
+
+        // Always present, a single thread runs the same fixed chunks inline so results don't
+        // change with the thread count
+        std::unique_ptr<ThreadPool> Pool;
+
+        // Object indices and start positions of the bodies with continuous collision integrated
+        // this step
+        std::vector<int> SweptObjects;
+        std::vector<Point2Df> SweepStarts;
+
+        // Swept bodies stopped at their time of impact this step, as object indices. Their position
+        // is already final, the solver only changes their velocity.
+        std::vector<int> ImpactObjects;
+
+        // Set when the step already synced the proxies for sweeping, UpdatePairs skips its own sync
+        bool ProxiesSynced;
+
+        // How far a swept body is let past its time of impact, so the narrowphase reports the contact
+        static constexpr float ImpactDepth = 0.25f;
+
+        // Awake movable objects copied out for the SIMD integrator, and their object indices
+        BodyStore Bodies;
+        std::vector<int> BodyObjects;
+
+        // Stands in for Bodies in fixed-point mode
+        FixedBodyStore FixedBodies;
+
+        // Collision shape of an object in fixed-point mode, a circle or its bounding box
+        struct FixedShape
+        {
+            bool Round;
+
+            FixedVector2 Center;
+            Fixed Radius;
+
+            FixedAABB Box;
+        };
+
+        // Indexed by shape slot, then by pair
+        std::vector<FixedShape> FixedShapes;
+        std::vector<Contact> PairContacts;
+        std::vector<uint8_t> PairHits;
+
+        // Bounds of every object index, gathered in parallel before the proxies are updated
+        std::vector<AABB> ObjectBounds;
+
+        // Contacts grouped so no two in a group move the same body. Groups run one after the
+        // other and the contacts within one in parallel, in any order, with identical results.
+        std::vector<uint64_t> BodyColors;
+        std::vector<int> ContactColors;
+        std::vector<int> ColorStart;
+        std::vector<int> ColorOrder;
+
+        // Contacts that found every color taken by their bodies, solved serially last
+        static constexpr int OverflowColor = 64;
+
+        // Impulses a contact ended its last solve with, the starting point of the next one
+        struct ContactImpulse
+        {
+            double Normal;
+            double Tangent;
+        };
+
+        // Solver state of a contact, in contact order
+        struct ContactConstraint
+        {
+            // Accumulated over the iterations, the normal one never pulls
+            double NormalImpulse;
+            double TangentImpulse;
+
+            double Friction;
+
+            // Separating speed asked for by restitution
+            double Bounce;
+        };
+
+        std::vector<ContactConstraint> Constraints;
+
+        // Keyed like ActivePairs and rewritten by every solve, so a pair that stops touching
+        // starts over from zero
+        std::unordered_map<uint64_t, ContactImpulse> Impulses;
+
+        // Positions when the solve started, the position passes measure how far contacts have
+        // already been pushed apart from them
+        std::vector<Vector2Df> SolveStart;
+
+        // Velocities when the solve started. Bodies were integrated with these, so they are moved
+        // by the change the velocity passes made times the step, as if the contacts had been
+        // solved before integrating. Otherwise a stack sinks a step's fall every tick.
+        std::vector<Vector2Df> SolveVelocities;
+
+        // Awake movable objects resting on the floor, held up by it during the velocity passes,
+        // and which object indices those are. The position passes don't push them into it.
+        std::vector<int> FloorObjects;
+        std::vector<uint8_t> OnFloor;
+
+        // Object indices the velocity change doesn't move, from ImpactObjects
+        std::vector<uint8_t> HoldPosition;
+
+        // Awake movable objects this substep: those integrated and those woken by a contact.
+        // The solver and sleeping passes only visit these.
+        std::vector<int> ActiveObjects;
+        std::vector<uint8_t> IsActive;
+
+        void GatherActive(std::vector<std::shared_ptr<RigidObject2D>>&);
+
+        // Overlap left alone, so resting contacts keep touching and don't flicker
+        static constexpr double ContactSlop = 0.5;
+
+        // Share of the remaining overlap removed by each position pass, and the most one pass
+        // moves a contact
+        static constexpr double CorrectionRate = 0.8;
+        static constexpr double MaxCorrection = 8;
+
+        uint64_t GetPairKey(const Contact&);
+
+        // Union-find over object indices, joined along contacts between movable bodies
+        std::vector<int> IslandParent;
+
+        // Shortest sleep time in each island, indexed by its root
+        std::vector<double> IslandRest;
+
+        int AwakeCount;
+
+        // Categories each category bit collides with, symmetric
+        uint32_t LayerMatrix[32];
+
+        // The object's mask narrowed by the layer matrix rows of its categories
+        uint32_t GetFilterMask(RigidObject2D&);
+
+        int FindIsland(int);
+
+        // One end asleep and the other asleep or immovable, such pairs are neither tested
+        // nor reported
+        static bool IsRestingPair(RigidObject2D&, RigidObject2D&);
+
+        // Advances every body's sleep timer, then puts islands that have all rested for
+        // TimeToSleep to sleep and wakes the sleeping members of every other island
+        void UpdateSleeping(std::vector<std::shared_ptr<RigidObject2D>>&, double);
+
+        void UpdateEvents();
+
+        // Fixed-point narrowphase over the pairs, a contact per touching pair in pair order
+        void CollideFixed(std::vector<std::shared_ptr<RigidObject2D>>&);
+
+        static bool TestFixed(const FixedShape&, const FixedShape&, Contact*);
+
+        void SyncProxies(std::vector<std::shared_ptr<RigidObject2D>>&);
+
+        void Integrate(std::vector<std::shared_ptr<RigidObject2D>>&, double);
+
+        // Moves the object back up to the floor and stops it falling further
+        void ApplyFloor(RigidObject2D&);
+
+        // Floor on the fixed-point grid in that mode
+        double GetFloorHeight();
+
+        // Moves every swept body back along its motion to its earliest time of impact
+        void SweepBodies(std::vector<std::shared_ptr<RigidObject2D>>&);
+
+        int ChooseSubsteps(std::vector<std::shared_ptr<RigidObject2D>>&, double);
+
+        void Substep(std::vector<std::shared_ptr<RigidObject2D>>&, double);
+
+        void ColorContacts(std::vector<std::shared_ptr<RigidObject2D>>&);
+
+        // Runs the function on every contact index, a color at a time with the contacts of
+        // a color in parallel
+        template<typename Function>
+        void ForEachColor(Function);
+
+        // Sequential impulse steps on one contact, in double precision or in Fixed
+        template<typename Scalar>
+        void PrepareContact(int, std::vector<std::shared_ptr<RigidObject2D>>&);
+
+        template<typename Scalar>
+        void WarmStartContact(int, std::vector<std::shared_ptr<RigidObject2D>>&);
+
+        template<typename Scalar>
+        void SolveContact(int, std::vector<std::shared_ptr<RigidObject2D>>&);
+
+        template<typename Scalar>
+        void CorrectContact(int, std::vector<std::shared_ptr<RigidObject2D>>&);
+
+        template<typename Scalar>
+        void SolveContacts(std::vector<std::shared_ptr<RigidObject2D>>&, double);
+
+        void SolveContacts(std::vector<std::shared_ptr<RigidObject2D>>&, double);
+
+    public:
+        // Objects below this height are moved back up to it after integrating and solving, and
+        // rub against it with their own friction
+        double Floor;
+
+        // Acceleration applied to every movable object on top of its forces
+        Vector2Df Gravity;
+
+        IntegrationScheme Integration;
+
+        // Step resolves contacts with a sequential impulse solver: friction and restitution
+        // from the bodies' materials, and position passes that push overlapping objects apart.
+        // Objects with a mass of 0 or less are immovable and never integrated.
+        bool ResolveContacts;
+
+        // Velocity passes over the contacts in every substep
+        int SolverIterations;
+
+        // Position passes over the contacts in every substep
+        int PositionIterations;
+
+        // Starts every contact from the impulses it ended the last solve with, so resting stacks
+        // keep their support instead of rebuilding it from zero and converge in a few passes
+        bool WarmStarting;
+
+        // Slower approaches than this don't bounce, so resting contacts settle
+        double RestitutionThreshold;
+
+        // Each Step is split into at least this many equal substeps
+        int Substeps;
+
+        // Largest time in seconds a substep may cover, more substeps are added to stay under it.
+        // 0 for no limit.
+        double MaxSubstepTime;
+
+        // Substeps are only added above Substeps while the fastest awake body would move more
+        // than AdaptiveTravel units in one, or the last step left a contact deeper than
+        // AdaptiveDepth, which doubles the count
+        bool AdaptiveSubsteps;
+
+        double AdaptiveTravel;
+        double AdaptiveDepth;
+
+        // Upper bound on substeps from MaxSubstepTime and the adaptive mode
+        int MaxSubsteps;
+
+        // Integrates, collides and solves in Q16.16 fixed point, so the same inputs give the
+        // same positions on any compiler, flag set, CPU and thread count. Positions must stay
+        // within +-32768 and the step time is rounded to 1/65536 of a second. Circles keep their
+        // shape, other objects collide as their bounding boxes. The broadphase and continuous
+        // collision stay in floats; their results are still reproducible, only less exact.
+        bool FixedPoint;
+
+        // Bodies slower than SleepVelocity, in units per second, for TimeToSleep seconds fall
+        // asleep together with everything they touch. Islands are only formed along contacts
+        // when ResolveContacts is set, otherwise every body sleeps on its own. A body that starts
+        // moving wakes what it touches, so waking spreads through a sleeping pile one contact
+        // per step. A sleeping body given a velocity from outside wakes on the next step.
+        bool AllowSleeping;
+
+        double SleepVelocity;
+        double TimeToSleep;
+
+        // Bodies integrated by the last substep
+        int GetAwakeCount();
+
+        // Substeps run by the last Step
+        int GetSubstepCount();
+
+        // Total threads used by the world, 0 for one per hardware thread
+        void SetThreadCount(int);
+
+        int GetThreadCount();
+
+        // Integrates every awake object and clears its force, stops bodies with continuous
+        // collision at their first impact, then detects and resolves contacts when enabled and
+        // updates which islands sleep. Runs as several substeps when set up to, contacts are
+        // those of the last. Bit-identical for any thread count.
+        void Step(std::vector<std::shared_ptr<RigidObject2D>>&, double);
+
+        // Whether objects in the two categories, given as bit indices from 0 to 31, may collide.
+        // Every pair of categories collides until disabled here; objects' own masks apply on top.
+        void SetLayerCollision(int, int, bool);
+        bool GetLayerCollision(int, int);
+
+        // Replaces the broadphase; proxies are recreated on the next update
+        void SetBroadphase(std::unique_ptr<Broadphase>);
+
+        Broadphase& GetBroadphase();
+
+        // Refreshes every proxy from its object's bounds and collects the overlapping pairs,
+        // sorted so the order doesn't depend on the broadphase. Sleeping objects keep the
+        // proxy they had when they fell asleep, and pairs of two sleeping objects are left out.
+        const std::vector<BodyPair>& UpdatePairs(std::vector<std::shared_ptr<RigidObject2D>>&);
+
+        const std::vector<BodyPair>& GetPairs();
+
+        // Updates the pairs, then runs the narrowphase over them. Only objects that are part of a
+        // pair have their shape built. Contacts refer to object indices and are sorted like pairs.
+        // Pairs with a sleeping end and a sleeping or immovable other end are skipped; they stay
+        // active without Stay events and end only once either side wakes and stops touching.
+        const std::vector<Contact>& UpdateContacts(std::vector<std::shared_ptr<RigidObject2D>>&);
+
+        const std::vector<Contact>& GetContacts();
+
+        // Begin and stay events in contact order, followed by end events sorted the same way.
+        // Rewritten by every UpdateContacts. After a Step with substeps, the begin and end
+        // events of the earlier substeps come first, in substep order.
+        const std::vector<ContactEvent>& GetContactEvents();
+
+        // Spatial queries over the objects as of the last UpdatePairs. Candidates come from the
+        // broadphase and are confirmed against the object's shape; DynamicAABBTree answers them
+        // in logarithmic time, the other backends scan their proxies. Only objects with a
+        // category in the mask are returned.
+        void QueryPoint(Vector2Df, std::vector<RigidObject2D*>&, uint32_t = 0xFFFFFFFF);
+        void QueryRegion(const AABB&, std::vector<RigidObject2D*>&, uint32_t = 0xFFFFFFFF);
+        void QueryCircle(Vector2Df, float, std::vector<RigidObject2D*>&, uint32_t = 0xFFFFFFFF);
+
+        // Closest object crossed by the segment between the two points
+        bool RayCast(Vector2Df, Vector2Df, RaycastHit&, uint32_t = 0xFFFFFFFF);
+
+        PhysicsWorld(std::unique_ptr<Broadphase> = nullptr);
+        PhysicsWorld(const PhysicsWorld&) = delete;
+
+        PhysicsWorld& operator =(const PhysicsWorld&) = delete;
+
+        virtual ~PhysicsWorld();
+    };
+}
+
+#endif // PHYSICSWORLD_H_
@@ -3,25 +3,132 @@
 
 #include <SDL2/SDL.h>
 #include <SDL_render.h>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstdio>
+#include <array>
+#include <memory>
+#include <string_view>
 #include "vertex.hpp"
+#include "camera.hpp"
 
 namespace CacoEngine
 {
+    class Object;
+
+    // Work submitted by the renderer during one frame
+    struct RenderStats
+    {
+        uint64_t DrawCalls;
+
+        uint64_t Vertices;
+
+        uint64_t Indices;
+
+        uint64_t TextureSwitches;
+
+        uint64_t ColorChanges;
+
+        // Objects or chunks skipped by visibility culling
+        uint64_t CulledObjects;
+
+        // Bytes written while converting or expanding data for submission
+        uint64_t BytesConverted;
+    };
+
     class Renderer
     {
     private:
+            static constexpr int StatsWindow = 120;
+
             SDL_Renderer* Instance;
 
+            RenderStats FrameStats;
+
+            // Ring buffer of the last StatsWindow completed frames
+            std::array<RenderStats, StatsWindow> StatsHistory;
+
+            int StatsIndex;
+
+            int StatsCount;
+
+            uint64_t FrameNumber;
+
+            SDL_Texture* LastTexture;
+
+            // Owned, so a renderer can be moved but never copied into a second fclose
+            std::unique_ptr<FILE, decltype(&fclose)> StatsDump;
+
+            // Persistent point buffers bucketed by packed draw color, drained by Flush()
+            std::unordered_map<uint32_t, std::vector<SDL_FPoint>> PointBatches;
+
+            // Wireframe segments expanded to hairline quads, colored per vertex
+            std::vector<Vertex2Df> LineBatch;
+            std::vector<int> LineIndices;
+
+            // World-to-viewport transform of the active camera, identity without one
+            CameraTransform Transform;
+
+            SDL_FRect VisibleArea;
+
+            bool HasCamera;
+
+            std::vector<Vertex2Df> TransformScratch;
+
+            void BatchLines(Object&);
+            void BatchPoints(Object&);
+
     public:
             RGBA Color;
 
             void Clear(RGBA = RGBA());
             void SetColor(RGBA);
 
+            // Submits a single object according to its FillMode.
+            // WireFrame and Points objects are queued and drawn on the next Flush()
+            void DrawObject(Object&);
+
+            // Submits all queued line and point batches, one call per batch
+            void Flush();
+
+            // Hands vertex storage straight to SDL_RenderGeometryRaw, no conversion or copy
+            void DrawGeometry(SDL_Texture*, const Vertex2Df*, int, const int* = nullptr, int = 0);
+
+            void DrawTexture(SDL_Texture*, const SDL_Rect* = nullptr, const SDL_Rect* = nullptr);
+
+            // Flushes pending batches, then clips to the camera's viewport and applies its transform
+            // to everything submitted until the next call. nullptr restores the full output, untransformed.
+            void SetCamera(const Camera*);
+
+            // Replaces the transform and the visible area without touching the viewport, for drawing
+            // world space content into a render target. Lasts until the next SetCamera.
+            void SetTransform(const CameraTransform&, SDL_FRect);
+
+            const CameraTransform& GetTransform();
+
+            // World space rectangle covered by the current viewport, for culling
+            SDL_FRect GetVisibleArea();
+
+            // Counters of the frame in progress, subsystems add their culling and conversion work here
+            RenderStats& GetFrameStats();
+
+            RenderStats GetLastFrameStats();
+
+            // Rolling mean and peak over the last StatsWindow frames
+            RenderStats GetAverageStats();
+            RenderStats GetPeakStats();
+
+            // Closes the frame's counters, appends them to the CSV dump if enabled
+            void EndFrame();
+
+            // Writes one CSV row per frame to the given file
+            bool EnableStatsDump(std::string_view);
+            void DisableStatsDump();
+
             SDL_Renderer* GetInstance();
 
             Renderer(SDL_Window* = nullptr);
-            ~Renderer();
     };
 }
 
@@ -11,16 +11,46 @@ namespace CacoEngine
     public:
         Vector2Df Velocity { Vector2Df(0, 0) };
 
+        // Applied by the last physics step, gravity included
         Vector2Df Acceleration { Vector2Df(0, 0) };
 
+        // Accumulated by AddForce and cleared by every physics step
         Vector2Df Force { Vector2Df(0, 0) };
 
         double Mass { 1.0f };
 
+        // Share of the approach speed kept when bouncing off another body, the larger of the two
+        // applies
+        double Restitution { 0 };
+
+        // Coulomb friction coefficient, the geometric mean of the two bodies' applies
+        double Friction { 0.3 };
+
         uint64_t LastUpdate;
 
+        // Set by the physics world once the body's island has rested long enough. Sleeping
+        // bodies are not integrated or moved in the broadphase. Giving one a velocity or a force
+        // wakes it; call Wake after moving one by hand.
+        bool Sleeping { false };
+
+        // Seconds spent below the world's sleep velocity
+        double SleepTime { 0 };
+
+        // Swept against the world every step and stopped at the first impact, so it can't pass
+        // through objects while moving further than their size per step. Costs a broadphase
+        // query per step, meant for small fast bodies like bullets.
+        bool ContinuousCollision { false };
+
+        void Wake();
+
+        // Also wakes the body
         void AddForce(Vector2Df);
 
+        // Changes the velocity at once by impulse / Mass and wakes the body, for one-off pushes
+        // that a force cleared by the next step would barely move. Immovable bodies ignore it.
+        void AddImpulse(Vector2Df);
+
+        // Acceleration from the accumulated force alone
         void UpdateAcceleration();
 
         RigidBody2D(Vector2Df = Vector2Df(), Vector2Df = Vector2Df(), Vector2Df = Vector2Df(), double = 1.0f);
@@ -2,18 +2,44 @@
 #define RIGIDOBJECT_H_
 
 #include "rigidbody.hpp"
+#include "aabb.hpp"
+#include "narrowphase.hpp"
 #include <cmath>
+#include <atomic>
+#include <cstdint>
 
 namespace CacoEngine
 {
     class RigidObject2D : public Object
     {
+    protected:
+        static std::atomic<uint64_t> NextPhysicsID;
+
+        // Unique for the life of the program, copies get their own. Unlike the address it is
+        // never reused, so a new object can't take over the physics state of a freed one.
+        uint64_t PhysicsID { NextPhysicsID++ };
+
     public:
         RigidBody2D RigidBody;
 
-        virtual bool CollidesWith(RigidObject2D);
+        // Category bits of the object and the categories it collides with. A pair is only
+        // tested when each one's category is in the other's mask.
+        uint32_t CollisionCategory { 1 };
+        uint32_t CollisionMask { 0xFFFFFFFF };
+
+        virtual bool CollidesWith(RigidObject2D&);
         virtual bool CollidesWith(Vector2Df);
 
+        // World space bounds used by the broadphase, derived from the mesh by default
+        virtual AABB GetBounds();
+
+        // Adds the object's collision shape and returns its shape ID. The default is the
+        // convex hull of the mesh.
+        virtual int AddShape(Narrowphase&);
+
+        uint64_t GetPhysicsID() const;
+
+        // Copies everything but the physics ID
         RigidObject2D& operator =(const RigidObject2D&);
 
         RigidObject2D();
@@ -33,10 +59,16 @@ namespace CacoEngine
             double GetRadius();
             void SetRadius(double);
 
+            using RigidObject2D::CollidesWith;
+
             bool CollidesWith(RigidCircle&);
 
             virtual bool CollidesWith(Vector2Df);
 
+            AABB GetBounds() override;
+
+            int AddShape(Narrowphase&) override;
+
             RigidCircle(Vector2Df, double = 1.0f);
             RigidCircle(RigidObject2D&);
 
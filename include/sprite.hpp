@@ -9,6 +9,9 @@ namespace CacoEngine
     class Sprite : public Rectangle
     {
     public:
+            // Shows only a region of the texture, e.g. one frame of a sprite sheet
+            void SetRegion(TextureRegion, bool = false, bool = false);
+
             Sprite(Texture, Vector2Df = Vector2Df(), Vector2Df = Vector2Df());
             virtual ~Sprite();
     };
@@ -0,0 +1,119 @@
+#ifndef TEXT_H_
+#define TEXT_H_
+
+#include <array>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>
+#include "drawable.hpp"
+#include "texture.hpp"
+#include "vertex.hpp"
+
+namespace CacoEngine
+{
+    struct Glyph
+    {
+        TextureRegion Region;
+
+        // Pixel size of the glyph in the atlas
+        Vector2D Size;
+
+        // Offset from the pen position to the glyph's top-left corner
+        Vector2D Offset;
+
+        // Pen advance after the glyph, 0 if the font has no such glyph
+        int Advance;
+
+        Glyph();
+    };
+
+    // Glyph atlas backed by a single texture, indexed directly by 8-bit character code
+    class BitmapFont
+    {
+    public:
+        Texture Atlas;
+
+        Vector2D AtlasSize;
+
+        int LineHeight;
+
+        std::array<Glyph, 256> Glyphs;
+
+        Glyph& GetGlyph(char);
+
+        // Appends one quad per visible glyph to the given buffer, starting at the pen position
+        void Layout(std::string_view, Vector2Df, RGBA, float, std::vector<Vertex2Df>&);
+
+        Vector2Df Measure(std::string_view, float = 1);
+
+        // Fixed-cell atlas with glyphs laid out row-major starting at firstCharacter
+        static std::shared_ptr<BitmapFont> LoadGrid(std::string_view path, Renderer&, Vector2D cellSize, int firstCharacter = 32, int count = 96);
+
+        // AngelCode BMFont text descriptor (.fnt), single page. nullptr when a number is malformed
+        // or a character lacks one of its fields
+        static std::shared_ptr<BitmapFont> LoadBMFont(std::string_view path, Renderer&);
+
+        BitmapFont(Texture = Texture(), int = 0);
+        ~BitmapFont();
+    };
+
+    struct TextEntry
+    {
+        std::string Content;
+
+        Vector2Df Position;
+
+        RGBA Color;
+
+        float Scale;
+
+        bool Visible;
+    };
+
+    // Set of strings sharing one font, drawn as a single geometry call.
+    // Glyph quads are cached and only laid out again after an entry changes.
+    class TextBatch : public Drawable
+    {
+    protected:
+        std::shared_ptr<BitmapFont> Font;
+
+        std::vector<TextEntry> Entries;
+
+        // Laid out quads of each entry, and whether the entry changed since
+        std::vector<std::vector<Vertex2Df>> EntryVertices;
+        std::vector<uint8_t> EntryDirty;
+
+        // Every visible entry's quads back to back, drawn in one call
+        std::vector<Vertex2Df> Vertices;
+
+        bool Dirty;
+
+        void MarkDirty(int);
+
+        // Lays out the changed entries only, then joins the cached quads
+        void Rebuild();
+
+    public:
+        int AddText(std::string_view, Vector2Df, RGBA = Colors[(int)Color::White], float = 1);
+
+        // No-op when the content is unchanged, so it is safe to call every frame
+        void SetText(int, std::string_view);
+
+        void SetPosition(int, Vector2Df);
+        void SetColor(int, RGBA);
+        void SetVisible(int, bool);
+
+        // The entry is laid out again on the next draw, as it may be changed through the reference
+        TextEntry& GetEntry(int);
+
+        void Clear();
+
+        void Draw(Renderer&) override;
+
+        TextBatch(std::shared_ptr<BitmapFont>);
+        virtual ~TextBatch();
+    };
+}
+
+#endif // TEXT_H_
@@ -8,11 +8,32 @@
 #include <SDL_image.h>
 #include <vector>
 #include <string_view>
+#include <memory>
+#include <atomic>
+#include <cstdint>
 #include "renderer.hpp"
 #include "surface.hpp"
 
 namespace CacoEngine
 {
+    enum class TextureState : uint8_t
+    {
+        Ready,
+        Loading,
+        Failed
+    };
+
+    // Shared by a texture handed out by TextureLoader and every copy of it
+    struct TextureSlot
+    {
+        // The placeholder until the upload, then the loaded texture. Only touched on the render thread.
+        SDL_Texture* Instance;
+
+        std::atomic<TextureState> State;
+
+        TextureSlot(SDL_Texture* = nullptr);
+    };
+
     class Texture
     {
     public:
@@ -20,6 +41,14 @@ namespace CacoEngine
 
         SDL_Texture* mTexture;
 
+        // Set on asynchronously loaded textures, mTexture is then the placeholder
+        std::shared_ptr<TextureSlot> Slot;
+
+        // What to draw: the loaded texture, or the placeholder while its load is in flight
+        SDL_Texture* GetInstance() const;
+
+        TextureState GetState() const;
+
         Texture(int = 0, SDL_Texture* = nullptr);
         Texture(const Texture&);
 
@@ -28,6 +57,17 @@ namespace CacoEngine
         ~Texture();
     };
 
+    // Sub-rectangle of a texture in normalized UV space
+    struct TextureRegion
+    {
+        float U0;
+        float V0;
+        float U1;
+        float V1;
+
+        TextureRegion(float = 0, float = 0, float = 1, float = 1);
+    };
+
     class TextureManager
     {
     public:
@@ -0,0 +1,102 @@
+#ifndef TEXTURELOADER_H_
+#define TEXTURELOADER_H_
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "renderer.hpp"
+#include "texture.hpp"
+
+namespace CacoEngine
+{
+    // Decodes images on worker threads and uploads them on the render thread a few at a time.
+    // Load returns at once with a texture that draws a transparent placeholder; the texture and
+    // every copy of it switch to the image once Upload has created it. SDL textures can only be
+    // created on the render thread, so decoding is the part that runs in parallel.
+    class TextureLoader
+    {
+    protected:
+        struct LoadRequest
+        {
+            std::string Path;
+
+            std::shared_ptr<TextureSlot> Slot;
+        };
+
+        struct DecodedImage
+        {
+            SDL_Surface* Image;
+
+            std::shared_ptr<TextureSlot> Slot;
+        };
+
+        std::vector<std::thread> Workers;
+
+        std::deque<LoadRequest> Requests;
+
+        std::deque<DecodedImage> Decoded;
+
+        std::mutex Lock;
+
+        // Wakes the workers for new requests
+        std::condition_variable Signal;
+
+        // Wakes Finish when an image is decoded or fails
+        std::condition_variable DecodeSignal;
+
+        bool Stopping;
+
+        // Loads that are neither uploaded nor failed yet
+        int Pending;
+
+        int ThreadCount;
+
+        // 1x1 transparent, created with the first load and destroyed by Stop
+        SDL_Texture* Placeholder;
+
+        // Failed loads still point at the placeholder, Stop detaches them before destroying it
+        std::vector<std::weak_ptr<TextureSlot>> FailedSlots;
+
+        void WorkerLoop();
+
+        void UploadImage(Renderer&, DecodedImage&);
+
+    public:
+        // Render-thread time one Upload call may spend, in milliseconds. At least one image is
+        // uploaded per call regardless, so loads always make progress.
+        double UploadBudget;
+
+        // Takes effect when the workers next start, 0 for one per hardware thread but the render thread's
+        void SetThreadCount(int);
+
+        // Call on the render thread. Size queries see the 1x1 placeholder until GetState is Ready.
+        Texture Load(std::string_view, Renderer&);
+
+        // Call on the render thread once per frame, returns the number of textures created
+        int Upload(Renderer&);
+
+        // Blocks until every queued load is uploaded or failed, for loading screens and startup
+        void Finish(Renderer&);
+
+        int GetPendingCount();
+
+        // Joins the workers and fails the loads still queued. Frees the placeholder and detaches the
+        // failed textures from it, so call it while the renderer is still alive.
+        void Stop();
+
+        TextureLoader();
+        TextureLoader(const TextureLoader&) = delete;
+
+        TextureLoader& operator =(const TextureLoader&) = delete;
+
+        ~TextureLoader();
+    };
+}
+
+#endif // TEXTURELOADER_H_
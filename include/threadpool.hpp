@@ -0,0 +1,66 @@
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+namespace CacoEngine
+{
+    // Fixed set of worker threads that split index ranges into chunks. Chunk boundaries depend
+    // only on the range and chunk size, never on how many threads pick them up, so results
+    // written per chunk come out the same on any machine.
+    class ThreadPool
+    {
+    protected:
+        std::vector<std::thread> Workers;
+
+        std::mutex Lock;
+        std::condition_variable WorkReady;
+        std::condition_variable WorkDone;
+
+        // Job currently being run, valid while Busy is non-zero
+        const std::function<void(int, int, int)>* Job;
+
+        int Count;
+        int ChunkSize;
+        int ChunkCount;
+
+        std::atomic<int> NextChunk;
+
+        // Workers that haven't finished the current job yet
+        int Busy;
+
+        uint64_t Generation;
+
+        bool Stopping;
+
+        void WorkerLoop(int);
+
+        // Claims chunks until none are left
+        void RunChunks(int);
+
+    public:
+        // Calls the function with (begin, end, thread) for every chunk of [0, count). Thread 0 is
+        // the caller, which takes part in the work; returns once every chunk is done.
+        // Runs inline when the range fits in one chunk or there are no workers.
+        void ParallelFor(int, int, const std::function<void(int, int, int)>&);
+
+        // Workers plus the calling thread
+        int GetThreadCount();
+
+        // Total threads including the caller, 0 uses one per hardware thread
+        ThreadPool(int = 0);
+        ThreadPool(const ThreadPool&) = delete;
+
+        ThreadPool& operator =(const ThreadPool&) = delete;
+
+        virtual ~ThreadPool();
+    };
+}
+
+#endif // THREADPOOL_H_
@@ -0,0 +1,84 @@
+#ifndef TILEMAP_H_
+#define TILEMAP_H_
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "drawable.hpp"
+#include "animation.hpp"
+
+namespace CacoEngine
+{
+    // Square block of tiles sharing one cached mesh
+    struct TileChunk
+    {
+        std::vector<Vertex2Df> Vertices;
+
+        // Quad index of every tile in the chunk inside Vertices, or NoQuad for empty tiles
+        std::vector<uint16_t> Quads;
+
+        bool Dirty;
+    };
+
+    // Dense grid of tile IDs rendered chunk by chunk. A chunk's mesh is built once, patched in
+    // place when a tile changes to another non-empty tile, and rebuilt only when tiles appear
+    // or disappear. Chunks outside the viewport are skipped entirely.
+    class Tilemap : public Drawable
+    {
+    protected:
+        static constexpr uint16_t NoQuad = 0xFFFF;
+
+        std::vector<uint16_t> Tiles;
+
+        std::vector<TileChunk> Chunks;
+
+        Vector2D Dimensions;
+
+        Vector2D ChunkCount;
+
+        int ChunkSize;
+
+        TileChunk& GetChunk(int, int);
+
+        void WriteQuad(Vertex2Df*, int, int, uint16_t);
+
+        void RebuildChunk(int, int);
+
+    public:
+        static constexpr uint16_t EmptyTile = 0;
+
+        // Tile N is drawn with frame N - 1 of the tileset; may be null for solid color tiles
+        std::shared_ptr<SpriteSheet> Tileset;
+
+        // Optional per-ID tint, tiles without an entry are drawn white
+        std::vector<RGBA> Palette;
+
+        // World position of the map's top-left corner
+        Vector2Df Position;
+
+        Vector2Df TileSize;
+
+        // Pixels left blank between neighbouring tiles
+        float Gap;
+
+        void SetTile(int, int, uint16_t);
+        uint16_t GetTile(int, int);
+
+        void Fill(uint16_t);
+
+        // Marks every chunk for rebuild, needed after changing Position, TileSize, Gap or Palette
+        void Invalidate();
+
+        // Tile coordinates containing the world position
+        Vector2D WorldToTile(Vector2Df);
+
+        Vector2D GetDimensions();
+
+        void Draw(Renderer&) override;
+
+        Tilemap(Vector2D dimensions, Vector2Df tileSize, std::shared_ptr<SpriteSheet> = nullptr, int chunkSize = 32);
+        virtual ~Tilemap();
+    };
+}
+
+#endif // TILEMAP_H_
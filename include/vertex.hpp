@@ -3,6 +3,7 @@
 
 #include <SDL2/SDL.h>
 #include <cmath>
+#include <cstdint>
 
 namespace CacoEngine
 {
@@ -83,6 +84,38 @@ namespace CacoEngine
         Vector2Df(double = 0, double = 0);
     };
 
+    // Single precision point used for vertex storage
+    struct Point2Df
+    {
+        float X;
+        float Y;
+
+        Point2Df& operator +=(Vector2Df);
+        Point2Df& operator -=(Vector2Df);
+
+        bool operator ==(const Point2Df&) const;
+
+        operator Vector2Df() const;
+
+        Point2Df(float = 0, float = 0);
+        Point2Df(Vector2Df);
+    };
+
+    // 8-bit per channel color, laid out like SDL_Color
+    struct Color32
+    {
+        uint8_t R;
+        uint8_t G;
+        uint8_t B;
+        uint8_t A;
+
+        bool operator ==(const Color32&) const;
+
+        operator RGBA() const;
+
+        Color32(RGBA = RGBA());
+    };
+
     struct Vertex2D
     {
         Vector2D Position;
@@ -101,13 +134,15 @@ namespace CacoEngine
         Vertex2D(Vector2D = Vector2D(), RGBA = RGBA(), Vector2D = Vector2D());
     };
 
+    // Laid out like SDL_Vertex (xy, rgba8, uv; 20 bytes), so mesh storage is handed to
+    // SDL_RenderGeometryRaw as strided arrays without conversion
     struct Vertex2Df
     {
-        Vector2Df Position;
+        Point2Df Position;
 
-        Vector2Df TextureCoordinates;
+        Color32 Color;
 
-        RGBA Color;
+        Point2Df TextureCoordinates;
 
         SDL_Vertex GetSDLVertex();
 
@@ -120,8 +155,11 @@ namespace CacoEngine
         bool operator ==(const Vertex2Df&) const;
 
         Vertex2Df(Vector2Df = Vector2Df(), RGBA = RGBA(), Vector2Df = Vector2Df());
+        Vertex2Df(Point2Df, Color32, Point2Df);
     };
 
+    static_assert(sizeof(Vertex2Df) == sizeof(SDL_Vertex), "Vertex2Df must match the SDL_Vertex layout");
+
     enum class Color
     {
         Red,
@@ -0,0 +1,85 @@
+#include "aabb.hpp"
+#include <algorithm>
+
+CacoEngine::AABB::AABB(float minX, float minY, float maxX, float maxY) : MinX(minX), MinY(minY), MaxX(maxX), MaxY(maxY) {}
+
+bool CacoEngine::AABB::Overlaps(const AABB& box) const
+{
+    return this->MinX <= box.MaxX && box.MinX <= this->MaxX && this->MinY <= box.MaxY && box.MinY <= this->MaxY;
+}
+
+bool CacoEngine::AABB::Contains(const AABB& box) const
+{
+    return this->MinX <= box.MinX && this->MinY <= box.MinY && box.MaxX <= this->MaxX && box.MaxY <= this->MaxY;
+}
+
+bool CacoEngine::AABB::Contains(Point2Df point) const
+{
+    return this->MinX <= point.X && point.X <= this->MaxX && this->MinY <= point.Y && point.Y <= this->MaxY;
+}
+
+CacoEngine::AABB CacoEngine::AABB::Merge(const AABB& box) const
+{
+    return AABB(std::min(this->MinX, box.MinX), std::min(this->MinY, box.MinY),
+                std::max(this->MaxX, box.MaxX), std::max(this->MaxY, box.MaxY));
+}
+
+CacoEngine::AABB CacoEngine::AABB::Expand(float margin) const
+{
+    return AABB(this->MinX - margin, this->MinY - margin, this->MaxX + margin, this->MaxY + margin);
+}
+
+CacoEngine::Point2Df CacoEngine::AABB::GetCenter() const
+{
+    return Point2Df((this->MinX + this->MaxX) * 0.5f, (this->MinY + this->MaxY) * 0.5f);
+}
+
+CacoEngine::Point2Df CacoEngine::AABB::GetExtents() const
+{
+    return Point2Df((this->MaxX - this->MinX) * 0.5f, (this->MaxY - this->MinY) * 0.5f);
+}
+
+float CacoEngine::AABB::GetPerimeter() const
+{
+    return 2 * ((this->MaxX - this->MinX) + (this->MaxY - this->MinY));
+}
+
+bool CacoEngine::AABB::IntersectsSegment(Point2Df start, Point2Df end, float* fraction) const
+{
+    float enter = 0, exit = 1;
+
+    float origin[2] = { start.X, start.Y };
+    float direction[2] = { end.X - start.X, end.Y - start.Y };
+    float minimum[2] = { this->MinX, this->MinY };
+    float maximum[2] = { this->MaxX, this->MaxY };
+
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (direction[axis] == 0)
+        {
+            // Parallel to this slab, either always inside it or never
+            if (origin[axis] < minimum[axis] || origin[axis] > maximum[axis])
+                return false;
+
+            continue;
+        }
+
+        float inverse = 1.0f / direction[axis];
+        float t0 = (minimum[axis] - origin[axis]) * inverse;
+        float t1 = (maximum[axis] - origin[axis]) * inverse;
+
+        if (t0 > t1)
+            std::swap(t0, t1);
+
+        enter = std::max(enter, t0);
+        exit = std::min(exit, t1);
+
+        if (enter > exit)
+            return false;
+    }
+
+    if (fraction)
+        *fraction = enter;
+
+    return true;
+}
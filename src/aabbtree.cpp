@@ -0,0 +1,461 @@
+#include "aabbtree.hpp"
+#include <algorithm>
+
+bool CacoEngine::DynamicAABBTree::Node::IsLeaf() const
+{
+    return this->Left == NullNode;
+}
+
+CacoEngine::DynamicAABBTree::DynamicAABBTree(float margin) : Root(NullNode), FreeList(NullNode), ProxyCount(0), Margin(margin) {}
+
+CacoEngine::DynamicAABBTree::~DynamicAABBTree() {}
+
+int CacoEngine::DynamicAABBTree::AllocateNode()
+{
+    int index;
+
+    if (this->FreeList != NullNode)
+    {
+        index = this->FreeList;
+        this->FreeList = this->Nodes[index].Parent;
+    }
+    else
+    {
+        index = this->Nodes.size();
+        this->Nodes.emplace_back();
+    }
+
+    Node& node = this->Nodes[index];
+
+    node.Parent = NullNode;
+    node.Left = NullNode;
+    node.Right = NullNode;
+    node.Height = 0;
+
+    return index;
+}
+
+void CacoEngine::DynamicAABBTree::FreeNode(int index)
+{
+    this->Nodes[index].Parent = this->FreeList;
+    this->Nodes[index].Height = -1;
+    this->FreeList = index;
+}
+
+void CacoEngine::DynamicAABBTree::InsertLeaf(int leaf)
+{
+    if (this->Root == NullNode)
+    {
+        this->Root = leaf;
+        this->Nodes[leaf].Parent = NullNode;
+        return;
+    }
+
+    AABB box = this->Nodes[leaf].Box;
+
+    // Descend towards the sibling that grows the total perimeter the least
+    int index = this->Root;
+
+    while (!this->Nodes[index].IsLeaf())
+    {
+        Node& node = this->Nodes[index];
+
+        float area = node.Box.GetPerimeter();
+        float combined = node.Box.Merge(box).GetPerimeter();
+
+        // Pairing with this node directly adds a new parent covering both
+        float cost = 2 * combined;
+
+        // Descending further grows this node's box regardless
+        float inheritance = 2 * (combined - area);
+
+        auto descendCost = [&](int child)
+        {
+            Node& other = this->Nodes[child];
+            float merged = other.Box.Merge(box).GetPerimeter();
+
+            return (other.IsLeaf() ? merged : merged - other.Box.GetPerimeter()) + inheritance;
+        };
+
+        float leftCost = descendCost(node.Left), rightCost = descendCost(node.Right);
+
+        if (cost < leftCost && cost < rightCost)
+            break;
+
+        index = (leftCost < rightCost) ? node.Left : node.Right;
+    }
+
+    int sibling = index;
+    int oldParent = this->Nodes[sibling].Parent;
+    int newParent = this->AllocateNode();
+
+    Node& parent = this->Nodes[newParent];
+
+    parent.Parent = oldParent;
+    parent.Box = box.Merge(this->Nodes[sibling].Box);
+    parent.Height = this->Nodes[sibling].Height + 1;
+    parent.Left = sibling;
+    parent.Right = leaf;
+
+    if (oldParent != NullNode)
+    {
+        if (this->Nodes[oldParent].Left == sibling)
+            this->Nodes[oldParent].Left = newParent;
+        else
+            this->Nodes[oldParent].Right = newParent;
+    }
+    else
+        this->Root = newParent;
+
+    this->Nodes[sibling].Parent = newParent;
+    this->Nodes[leaf].Parent = newParent;
+
+    this->Refit(this->Nodes[leaf].Parent);
+}
+
+void CacoEngine::DynamicAABBTree::RemoveLeaf(int leaf)
+{
+    if (leaf == this->Root)
+    {
+        this->Root = NullNode;
+        return;
+    }
+
+    int parent = this->Nodes[leaf].Parent;
+    int grandParent = this->Nodes[parent].Parent;
+    int sibling = (this->Nodes[parent].Left == leaf) ? this->Nodes[parent].Right : this->Nodes[parent].Left;
+
+    // The sibling takes the parent's place
+    if (grandParent != NullNode)
+    {
+        if (this->Nodes[grandParent].Left == parent)
+            this->Nodes[grandParent].Left = sibling;
+        else
+            this->Nodes[grandParent].Right = sibling;
+
+        this->Nodes[sibling].Parent = grandParent;
+        this->FreeNode(parent);
+
+        this->Refit(grandParent);
+    }
+    else
+    {
+        this->Root = sibling;
+        this->Nodes[sibling].Parent = NullNode;
+        this->FreeNode(parent);
+    }
+}
+
+void CacoEngine::DynamicAABBTree::Refit(int index)
+{
+    while (index != NullNode)
+    {
+        index = this->Balance(index);
+
+        Node& node = this->Nodes[index];
+        Node& left = this->Nodes[node.Left];
+        Node& right = this->Nodes[node.Right];
+
+        node.Height = 1 + std::max(left.Height, right.Height);
+        node.Box = left.Box.Merge(right.Box);
+
+        index = node.Parent;
+    }
+}
+
+int CacoEngine::DynamicAABBTree::Balance(int indexA)
+{
+    Node& a = this->Nodes[indexA];
+
+    if (a.IsLeaf() || a.Height < 2)
+        return indexA;
+
+    int indexB = a.Left, indexC = a.Right;
+
+    Node& b = this->Nodes[indexB];
+    Node& c = this->Nodes[indexC];
+
+    int balance = c.Height - b.Height;
+
+    // Rotate C up
+    if (balance > 1)
+    {
+        int indexF = c.Left, indexG = c.Right;
+
+        Node& f = this->Nodes[indexF];
+        Node& g = this->Nodes[indexG];
+
+        c.Left = indexA;
+        c.Parent = a.Parent;
+        a.Parent = indexC;
+
+        if (c.Parent != NullNode)
+        {
+            if (this->Nodes[c.Parent].Left == indexA)
+                this->Nodes[c.Parent].Left = indexC;
+            else
+                this->Nodes[c.Parent].Right = indexC;
+        }
+        else
+            this->Root = indexC;
+
+        // The taller grandchild stays under C, the shorter one moves to A
+        if (f.Height > g.Height)
+        {
+            c.Right = indexF;
+            a.Right = indexG;
+            g.Parent = indexA;
+
+            a.Box = b.Box.Merge(g.Box);
+            c.Box = a.Box.Merge(f.Box);
+
+            a.Height = 1 + std::max(b.Height, g.Height);
+            c.Height = 1 + std::max(a.Height, f.Height);
+        }
+        else
+        {
+            c.Right = indexG;
+            a.Right = indexF;
+            f.Parent = indexA;
+
+            a.Box = b.Box.Merge(f.Box);
+            c.Box = a.Box.Merge(g.Box);
+
+            a.Height = 1 + std::max(b.Height, f.Height);
+            c.Height = 1 + std::max(a.Height, g.Height);
+        }
+
+        return indexC;
+    }
+
+    // Rotate B up
+    if (balance < -1)
+    {
+        int indexD = b.Left, indexE = b.Right;
+
+        Node& d = this->Nodes[indexD];
+        Node& e = this->Nodes[indexE];
+
+        b.Left = indexA;
+        b.Parent = a.Parent;
+        a.Parent = indexB;
+
+        if (b.Parent != NullNode)
+        {
+            if (this->Nodes[b.Parent].Left == indexA)
+                this->Nodes[b.Parent].Left = indexB;
+            else
+                this->Nodes[b.Parent].Right = indexB;
+        }
+        else
+            this->Root = indexB;
+
+        if (d.Height > e.Height)
+        {
+            b.Right = indexD;
+            a.Left = indexE;
+            e.Parent = indexA;
+
+            a.Box = c.Box.Merge(e.Box);
+            b.Box = a.Box.Merge(d.Box);
+
+            a.Height = 1 + std::max(c.Height, e.Height);
+            b.Height = 1 + std::max(a.Height, d.Height);
+        }
+        else
+        {
+            b.Right = indexE;
+            a.Left = indexD;
+            d.Parent = indexA;
+
+            a.Box = c.Box.Merge(d.Box);
+            b.Box = a.Box.Merge(e.Box);
+
+            a.Height = 1 + std::max(c.Height, d.Height);
+            b.Height = 1 + std::max(a.Height, e.Height);
+        }
+
+        return indexB;
+    }
+
+    return indexA;
+}
+
+int CacoEngine::DynamicAABBTree::CreateProxy(const AABB& bounds)
+{
+    int leaf = this->AllocateNode();
+
+    this->Nodes[leaf].Tight = bounds;
+    this->Nodes[leaf].Box = bounds.Expand(this->Margin);
+
+    this->InsertLeaf(leaf);
+    this->ProxyCount++;
+
+    this->SetProxyFilter(leaf, 1, 0xFFFFFFFF);
+    this->AddActive(leaf);
+
+    return leaf;
+}
+
+void CacoEngine::DynamicAABBTree::DestroyProxy(int proxy)
+{
+    if (proxy < 0 || proxy >= this->Nodes.size() || this->Nodes[proxy].Height != 0)
+        return;
+
+    this->RemoveLeaf(proxy);
+    this->FreeNode(proxy);
+    this->ProxyCount--;
+
+    this->RemoveActive(proxy);
+    this->Resting[proxy] = 0;
+}
+
+void CacoEngine::DynamicAABBTree::MoveProxy(int proxy, const AABB& bounds)
+{
+    if (proxy < 0 || proxy >= this->Nodes.size() || this->Nodes[proxy].Height != 0)
+        return;
+
+    this->Nodes[proxy].Tight = bounds;
+
+    if (this->Nodes[proxy].Box.Contains(bounds))
+        return;
+
+    this->RemoveLeaf(proxy);
+
+    this->Nodes[proxy].Box = bounds.Expand(this->Margin);
+
+    this->InsertLeaf(proxy);
+}
+
+void CacoEngine::DynamicAABBTree::FindPairs(std::vector<BroadphasePair>& pairs)
+{
+    pairs.clear();
+
+    if (this->Root == NullNode)
+        return;
+
+    // Resting leaves are only found from the active ones they touch
+    for (int x = 0; x < this->ActiveProxies.size(); x++)
+    {
+        int leaf = this->ActiveProxies[x];
+
+        AABB tight = this->Nodes[leaf].Tight;
+
+        this->Stack.clear();
+        this->Stack.push_back(this->Root);
+
+        while (!this->Stack.empty())
+        {
+            int index = this->Stack.back();
+            this->Stack.pop_back();
+
+            Node& node = this->Nodes[index];
+
+            if (!node.Box.Overlaps(tight))
+                continue;
+
+            if (node.IsLeaf())
+            {
+                // A pair of active leaves is found from both ends, keep the one from the lower ID
+                bool resting = this->IsProxyResting(index);
+
+                if ((resting || index > leaf) && index != leaf && this->CanPair(leaf, index) && node.Tight.Overlaps(tight))
+                    pairs.emplace_back(std::min(leaf, index), std::max(leaf, index));
+            }
+            else
+            {
+                this->Stack.push_back(node.Left);
+                this->Stack.push_back(node.Right);
+            }
+        }
+    }
+}
+
+void CacoEngine::DynamicAABBTree::QueryRegion(const AABB& region, std::vector<int>& proxies)
+{
+    if (this->Root == NullNode)
+        return;
+
+    this->Stack.clear();
+    this->Stack.push_back(this->Root);
+
+    while (!this->Stack.empty())
+    {
+        int index = this->Stack.back();
+        this->Stack.pop_back();
+
+        Node& node = this->Nodes[index];
+
+        if (!node.Box.Overlaps(region))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            if (node.Tight.Overlaps(region))
+                proxies.push_back(index);
+        }
+        else
+        {
+            this->Stack.push_back(node.Left);
+            this->Stack.push_back(node.Right);
+        }
+    }
+}
+
+void CacoEngine::DynamicAABBTree::QueryRay(Point2Df start, Point2Df end, std::vector<int>& proxies)
+{
+    if (this->Root == NullNode)
+        return;
+
+    this->Stack.clear();
+    this->Stack.push_back(this->Root);
+
+    while (!this->Stack.empty())
+    {
+        int index = this->Stack.back();
+        this->Stack.pop_back();
+
+        Node& node = this->Nodes[index];
+
+        if (!node.Box.IntersectsSegment(start, end))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            if (node.Tight.IntersectsSegment(start, end))
+                proxies.push_back(index);
+        }
+        else
+        {
+            this->Stack.push_back(node.Left);
+            this->Stack.push_back(node.Right);
+        }
+    }
+}
+
+void CacoEngine::DynamicAABBTree::Clear()
+{
+    this->Nodes.clear();
+    this->Root = NullNode;
+    this->FreeList = NullNode;
+    this->ProxyCount = 0;
+
+    this->ActiveProxies.clear();
+    this->ActiveSlots.clear();
+    this->Resting.clear();
+}
+
+int CacoEngine::DynamicAABBTree::GetProxyCount()
+{
+    return this->ProxyCount;
+}
+
+const CacoEngine::AABB& CacoEngine::DynamicAABBTree::GetFatBounds(int proxy)
+{
+    return this->Nodes[proxy].Box;
+}
+
+int CacoEngine::DynamicAABBTree::GetHeight()
+{
+    return (this->Root == NullNode) ? -1 : this->Nodes[this->Root].Height;
+}
@@ -0,0 +1,269 @@
+#include "animation.hpp"
+#include <SDL_render.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+CacoEngine::SpriteSheet::SpriteSheet(Texture texture, Vector2D size) : SheetTexture(texture), Size(size)
+{
+    if (this->Size.X > 0 && this->Size.Y > 0)
+        return;
+
+    // A texture still loading would report the placeholder's size
+    if (texture.GetState() == TextureState::Loading)
+        std::cout << "Sprite sheet texture is still loading, pass its size explicitly\n";
+    else if (texture.GetInstance())
+        SDL_QueryTexture(texture.GetInstance(), nullptr, nullptr, &this->Size.X, &this->Size.Y);
+}
+
+CacoEngine::SpriteSheet::~SpriteSheet()
+{
+}
+
+int CacoEngine::SpriteSheet::AddFrame(Vector2D position, Vector2D dimensions)
+{
+    float width = (this->Size.X > 0) ? this->Size.X : 1, height = (this->Size.Y > 0) ? this->Size.Y : 1;
+
+    this->Frames.push_back(TextureRegion(position.X / width, position.Y / height,
+                                         (position.X + dimensions.X) / width, (position.Y + dimensions.Y) / height));
+
+    return this->Frames.size() - 1;
+}
+
+int CacoEngine::SpriteSheet::AddGrid(Vector2D frameSize, int count)
+{
+    int first = this->Frames.size();
+
+    if (frameSize.X <= 0 || frameSize.Y <= 0)
+        return first;
+
+    int columns = this->Size.X / frameSize.X, rows = this->Size.Y / frameSize.Y;
+
+    if (count < 0 || count > columns * rows)
+        count = columns * rows;
+
+    this->Frames.reserve(first + count);
+
+    for (int x = 0; x < count; x++)
+        this->AddFrame(Vector2D((x % columns) * frameSize.X, (x / columns) * frameSize.Y), frameSize);
+
+    return first;
+}
+
+CacoEngine::TextureRegion& CacoEngine::SpriteSheet::GetFrame(int index)
+{
+    return this->Frames[index];
+}
+
+CacoEngine::AnimationClip::AnimationClip(std::shared_ptr<SpriteSheet> sheet, std::vector<uint16_t> frames, float frameDuration, bool loop)
+    : Sheet(sheet), Frames(frames), FrameDuration(frameDuration), Loop(loop)
+{
+}
+
+CacoEngine::AnimationSystem::AnimationSystem()
+{
+}
+
+CacoEngine::AnimationSystem::~AnimationSystem()
+{
+}
+
+int CacoEngine::AnimationSystem::AddClip(AnimationClip clip)
+{
+    this->Clips.push_back(clip);
+
+    return this->Clips.size() - 1;
+}
+
+CacoEngine::AnimationClip& CacoEngine::AnimationSystem::GetClip(int clip)
+{
+    return this->Clips[clip];
+}
+
+int CacoEngine::AnimationSystem::AddAnimator(std::shared_ptr<Object> target, int clip)
+{
+    int index = this->Targets.size(), handle;
+
+    if (!this->FreeHandles.empty())
+    {
+        handle = this->FreeHandles.back();
+        this->FreeHandles.pop_back();
+        this->HandleToIndex[handle] = index;
+    }
+    else
+    {
+        handle = this->HandleToIndex.size();
+        this->HandleToIndex.push_back(index);
+    }
+
+    if (this->Clips[clip].Sheet)
+        target->mTexture = this->Clips[clip].Sheet->SheetTexture;
+
+    this->Targets.push_back(std::move(target));
+    this->ClipIndices.push_back(clip);
+    this->CurrentFrames.push_back(0);
+    this->Times.push_back(0);
+    this->Speeds.push_back(1);
+    this->Flags.push_back(Playing);
+    this->IndexToHandle.push_back(handle);
+
+    this->ApplyFrame(index);
+
+    return handle;
+}
+
+void CacoEngine::AnimationSystem::RemoveAnimator(int handle)
+{
+    int index = this->HandleToIndex[handle], last = this->Targets.size() - 1;
+
+    // Swap-remove, then patch the handle of the animator that moved into the hole
+    if (index != last)
+    {
+        this->Targets[index] = std::move(this->Targets[last]);
+        this->ClipIndices[index] = this->ClipIndices[last];
+        this->CurrentFrames[index] = this->CurrentFrames[last];
+        this->Times[index] = this->Times[last];
+        this->Speeds[index] = this->Speeds[last];
+        this->Flags[index] = this->Flags[last];
+        this->IndexToHandle[index] = this->IndexToHandle[last];
+
+        this->HandleToIndex[this->IndexToHandle[index]] = index;
+    }
+
+    this->Targets.pop_back();
+    this->ClipIndices.pop_back();
+    this->CurrentFrames.pop_back();
+    this->Times.pop_back();
+    this->Speeds.pop_back();
+    this->Flags.pop_back();
+    this->IndexToHandle.pop_back();
+
+    this->HandleToIndex[handle] = -1;
+    this->FreeHandles.push_back(handle);
+}
+
+void CacoEngine::AnimationSystem::Play(int handle, int clip, bool restart)
+{
+    int index = this->HandleToIndex[handle];
+
+    if (this->ClipIndices[index] == clip && !restart)
+    {
+        this->Flags[index] |= Playing;
+        return;
+    }
+
+    // Switching between clips on the same sheet costs no texture change
+    if (this->Clips[clip].Sheet)
+    {
+        Texture& sheet = this->Clips[clip].Sheet->SheetTexture;
+
+        // Pending loads all share the placeholder, so their slots tell them apart
+        if (sheet.mTexture != this->Targets[index]->mTexture.mTexture || sheet.Slot != this->Targets[index]->mTexture.Slot)
+            this->Targets[index]->mTexture = sheet;
+    }
+
+    this->ClipIndices[index] = clip;
+    this->CurrentFrames[index] = 0;
+    this->Times[index] = 0;
+    this->Flags[index] |= Playing;
+
+    this->ApplyFrame(index);
+}
+
+void CacoEngine::AnimationSystem::Pause(int handle)
+{
+    this->Flags[this->HandleToIndex[handle]] &= ~Playing;
+}
+
+void CacoEngine::AnimationSystem::Resume(int handle)
+{
+    this->Flags[this->HandleToIndex[handle]] |= Playing;
+}
+
+void CacoEngine::AnimationSystem::SetFlip(int handle, bool x, bool y)
+{
+    int index = this->HandleToIndex[handle];
+    uint8_t flags = (this->Flags[index] & ~(FlipX | FlipY)) | ((x) ? FlipX : 0) | ((y) ? FlipY : 0);
+
+    if (flags == this->Flags[index])
+        return;
+
+    this->Flags[index] = flags;
+    this->ApplyFrame(index);
+}
+
+void CacoEngine::AnimationSystem::SetSpeed(int handle, float speed)
+{
+    this->Speeds[this->HandleToIndex[handle]] = speed;
+}
+
+bool CacoEngine::AnimationSystem::IsPlaying(int handle)
+{
+    return (this->Flags[this->HandleToIndex[handle]] & Playing) != 0;
+}
+
+int CacoEngine::AnimationSystem::GetFrame(int handle)
+{
+    return this->CurrentFrames[this->HandleToIndex[handle]];
+}
+
+int CacoEngine::AnimationSystem::GetAnimatorCount()
+{
+    return this->Targets.size();
+}
+
+void CacoEngine::AnimationSystem::ApplyFrame(int index)
+{
+    AnimationClip& clip = this->Clips[this->ClipIndices[index]];
+
+    if (!clip.Sheet || clip.Frames.empty())
+        return;
+
+    this->Targets[index]->ObjectMesh.SetQuadRegion(clip.Sheet->Frames[clip.Frames[this->CurrentFrames[index]]],
+                                                   (this->Flags[index] & FlipX) != 0,
+                                                   (this->Flags[index] & FlipY) != 0);
+}
+
+void CacoEngine::AnimationSystem::Update(double deltaTime)
+{
+    int count = this->Targets.size();
+
+    for (int x = 0; x < count; x++)
+    {
+        if (!(this->Flags[x] & Playing))
+            continue;
+
+        AnimationClip& clip = this->Clips[this->ClipIndices[x]];
+        int frameCount = clip.Frames.size();
+
+        if (frameCount <= 1 || clip.FrameDuration <= 0)
+            continue;
+
+        float duration = clip.FrameDuration * frameCount;
+        float time = this->Times[x] + (float)deltaTime * this->Speeds[x];
+
+        if (clip.Loop)
+        {
+            time = std::fmod(time, duration);
+
+            // Negative speeds play backwards, fmod keeps the sign of the time
+            if (time < 0)
+                time += duration;
+        }
+        else if (time >= duration || (time <= 0 && this->Speeds[x] < 0))
+        {
+            time = std::min(std::max(time, 0.0f), duration);
+            this->Flags[x] &= ~Playing;
+        }
+
+        this->Times[x] = time;
+
+        int frame = std::min(std::max((int)(time / clip.FrameDuration), 0), frameCount - 1);
+
+        if (frame != this->CurrentFrames[x])
+        {
+            this->CurrentFrames[x] = frame;
+            this->ApplyFrame(x);
+        }
+    }
+}
@@ -0,0 +1,606 @@
+#include "bodystore.hpp"
+#include <algorithm>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+CacoEngine::BodyStore::BodyStore(int capacity) : Count(0), Scheme(IntegrationScheme::SemiImplicitEuler), Gravity(Vector2Df())
+{
+    capacity = std::max(capacity, 0);
+
+    this->PositionX.reserve(capacity);
+    this->PositionY.reserve(capacity);
+    this->VelocityX.reserve(capacity);
+    this->VelocityY.reserve(capacity);
+    this->ForceX.reserve(capacity);
+    this->ForceY.reserve(capacity);
+    this->InverseMass.reserve(capacity);
+}
+
+CacoEngine::BodyStore::~BodyStore()
+{
+}
+
+int CacoEngine::BodyStore::Add(Vector2Df position, Vector2Df velocity, float mass)
+{
+    int index = this->Count;
+
+    this->Resize(this->Count + 1);
+
+    this->SetPosition(index, position);
+    this->SetVelocity(index, velocity);
+    this->SetMass(index, mass);
+
+    return index;
+}
+
+void CacoEngine::BodyStore::Remove(int index)
+{
+    int last = this->Count - 1;
+
+    this->PositionX[index] = this->PositionX[last];
+    this->PositionY[index] = this->PositionY[last];
+    this->VelocityX[index] = this->VelocityX[last];
+    this->VelocityY[index] = this->VelocityY[last];
+    this->ForceX[index] = this->ForceX[last];
+    this->ForceY[index] = this->ForceY[last];
+    this->InverseMass[index] = this->InverseMass[last];
+
+    this->Resize(last);
+}
+
+void CacoEngine::BodyStore::Resize(int count)
+{
+    this->Count = std::max(count, 0);
+
+    this->PositionX.resize(this->Count, 0);
+    this->PositionY.resize(this->Count, 0);
+    this->VelocityX.resize(this->Count, 0);
+    this->VelocityY.resize(this->Count, 0);
+    this->ForceX.resize(this->Count, 0);
+    this->ForceY.resize(this->Count, 0);
+    this->InverseMass.resize(this->Count, 1);
+}
+
+void CacoEngine::BodyStore::Clear()
+{
+    this->Resize(0);
+}
+
+int CacoEngine::BodyStore::GetCount()
+{
+    return this->Count;
+}
+
+CacoEngine::Vector2Df CacoEngine::BodyStore::GetPosition(int index)
+{
+    return Vector2Df(this->PositionX[index], this->PositionY[index]);
+}
+
+void CacoEngine::BodyStore::SetPosition(int index, Vector2Df position)
+{
+    this->PositionX[index] = position.X;
+    this->PositionY[index] = position.Y;
+}
+
+CacoEngine::Vector2Df CacoEngine::BodyStore::GetVelocity(int index)
+{
+    return Vector2Df(this->VelocityX[index], this->VelocityY[index]);
+}
+
+void CacoEngine::BodyStore::SetVelocity(int index, Vector2Df velocity)
+{
+    this->VelocityX[index] = velocity.X;
+    this->VelocityY[index] = velocity.Y;
+}
+
+float CacoEngine::BodyStore::GetInverseMass(int index)
+{
+    return this->InverseMass[index];
+}
+
+void CacoEngine::BodyStore::SetMass(int index, float mass)
+{
+    this->InverseMass[index] = (mass > 0) ? 1.0f / mass : 0;
+}
+
+void CacoEngine::BodyStore::AddForce(int index, Vector2Df force)
+{
+    this->ForceX[index] += force.X;
+    this->ForceY[index] += force.Y;
+}
+
+void CacoEngine::BodyStore::SetForce(int index, Vector2Df force)
+{
+    this->ForceX[index] = force.X;
+    this->ForceY[index] = force.Y;
+}
+
+void CacoEngine::BodyStore::IntegrateEuler(int begin, int end, float deltaTime)
+{
+    float gravityX = this->Gravity.X, gravityY = this->Gravity.Y;
+
+    float* px = this->PositionX.data();
+    float* py = this->PositionY.data();
+    float* vx = this->VelocityX.data();
+    float* vy = this->VelocityY.data();
+    float* fx = this->ForceX.data();
+    float* fy = this->ForceY.data();
+    float* inverse = this->InverseMass.data();
+
+    int x = begin;
+
+#if defined(__AVX2__)
+    __m256 dt8 = _mm256_set1_ps(deltaTime), zero8 = _mm256_setzero_ps();
+    __m256 gx8 = _mm256_set1_ps(gravityX), gy8 = _mm256_set1_ps(gravityY);
+
+    for (; x + 8 <= end; x += 8)
+    {
+        __m256 inverse8 = _mm256_loadu_ps(inverse + x);
+
+        // Immovable lanes get no acceleration at all, gravity included
+        __m256 movable = _mm256_cmp_ps(inverse8, zero8, _CMP_GT_OQ);
+
+        __m256 accelerationX = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(fx + x), inverse8), gx8), movable);
+        __m256 accelerationY = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(fy + x), inverse8), gy8), movable);
+
+        __m256 velocityX = _mm256_add_ps(_mm256_loadu_ps(vx + x), _mm256_mul_ps(accelerationX, dt8));
+        __m256 velocityY = _mm256_add_ps(_mm256_loadu_ps(vy + x), _mm256_mul_ps(accelerationY, dt8));
+
+        _mm256_storeu_ps(vx + x, velocityX);
+        _mm256_storeu_ps(vy + x, velocityY);
+        _mm256_storeu_ps(px + x, _mm256_add_ps(_mm256_loadu_ps(px + x), _mm256_mul_ps(velocityX, dt8)));
+        _mm256_storeu_ps(py + x, _mm256_add_ps(_mm256_loadu_ps(py + x), _mm256_mul_ps(velocityY, dt8)));
+        _mm256_storeu_ps(fx + x, zero8);
+        _mm256_storeu_ps(fy + x, zero8);
+    }
+#elif defined(__SSE2__)
+    __m128 dt4 = _mm_set1_ps(deltaTime), zero4 = _mm_setzero_ps();
+    __m128 gx4 = _mm_set1_ps(gravityX), gy4 = _mm_set1_ps(gravityY);
+
+    for (; x + 4 <= end; x += 4)
+    {
+        __m128 inverse4 = _mm_loadu_ps(inverse + x);
+        __m128 movable = _mm_cmpgt_ps(inverse4, zero4);
+
+        __m128 accelerationX = _mm_and_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(fx + x), inverse4), gx4), movable);
+        __m128 accelerationY = _mm_and_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(fy + x), inverse4), gy4), movable);
+
+        __m128 velocityX = _mm_add_ps(_mm_loadu_ps(vx + x), _mm_mul_ps(accelerationX, dt4));
+        __m128 velocityY = _mm_add_ps(_mm_loadu_ps(vy + x), _mm_mul_ps(accelerationY, dt4));
+
+        _mm_storeu_ps(vx + x, velocityX);
+        _mm_storeu_ps(vy + x, velocityY);
+        _mm_storeu_ps(px + x, _mm_add_ps(_mm_loadu_ps(px + x), _mm_mul_ps(velocityX, dt4)));
+        _mm_storeu_ps(py + x, _mm_add_ps(_mm_loadu_ps(py + x), _mm_mul_ps(velocityY, dt4)));
+        _mm_storeu_ps(fx + x, zero4);
+        _mm_storeu_ps(fy + x, zero4);
+    }
+#endif
+
+    // Scalar tail, and the whole range on targets without SSE
+    for (; x < end; x++)
+    {
+        float accelerationX = (inverse[x] > 0) ? fx[x] * inverse[x] + gravityX : 0;
+        float accelerationY = (inverse[x] > 0) ? fy[x] * inverse[x] + gravityY : 0;
+
+        vx[x] += accelerationX * deltaTime;
+        vy[x] += accelerationY * deltaTime;
+        px[x] += vx[x] * deltaTime;
+        py[x] += vy[x] * deltaTime;
+        fx[x] = 0;
+        fy[x] = 0;
+    }
+}
+
+void CacoEngine::BodyStore::IntegrateVerlet(int begin, int end, float deltaTime)
+{
+    float gravityX = this->Gravity.X, gravityY = this->Gravity.Y;
+    float half = deltaTime * 0.5f;
+
+    float* px = this->PositionX.data();
+    float* py = this->PositionY.data();
+    float* vx = this->VelocityX.data();
+    float* vy = this->VelocityY.data();
+    float* fx = this->ForceX.data();
+    float* fy = this->ForceY.data();
+    float* inverse = this->InverseMass.data();
+
+    int x = begin;
+
+#if defined(__AVX2__)
+    __m256 dt8 = _mm256_set1_ps(deltaTime), half8 = _mm256_set1_ps(half), zero8 = _mm256_setzero_ps();
+    __m256 gx8 = _mm256_set1_ps(gravityX), gy8 = _mm256_set1_ps(gravityY);
+
+    for (; x + 8 <= end; x += 8)
+    {
+        __m256 inverse8 = _mm256_loadu_ps(inverse + x);
+        __m256 movable = _mm256_cmp_ps(inverse8, zero8, _CMP_GT_OQ);
+
+        __m256 accelerationX = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(fx + x), inverse8), gx8), movable);
+        __m256 accelerationY = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(fy + x), inverse8), gy8), movable);
+
+        __m256 velocityX = _mm256_loadu_ps(vx + x);
+        __m256 velocityY = _mm256_loadu_ps(vy + x);
+
+        // p += (v + a * dt / 2) * dt
+        _mm256_storeu_ps(px + x, _mm256_add_ps(_mm256_loadu_ps(px + x), _mm256_mul_ps(_mm256_add_ps(velocityX, _mm256_mul_ps(accelerationX, half8)), dt8)));
+        _mm256_storeu_ps(py + x, _mm256_add_ps(_mm256_loadu_ps(py + x), _mm256_mul_ps(_mm256_add_ps(velocityY, _mm256_mul_ps(accelerationY, half8)), dt8)));
+        _mm256_storeu_ps(vx + x, _mm256_add_ps(velocityX, _mm256_mul_ps(accelerationX, dt8)));
+        _mm256_storeu_ps(vy + x, _mm256_add_ps(velocityY, _mm256_mul_ps(accelerationY, dt8)));
+        _mm256_storeu_ps(fx + x, zero8);
+        _mm256_storeu_ps(fy + x, zero8);
+    }
+#elif defined(__SSE2__)
+    __m128 dt4 = _mm_set1_ps(deltaTime), half4 = _mm_set1_ps(half), zero4 = _mm_setzero_ps();
+    __m128 gx4 = _mm_set1_ps(gravityX), gy4 = _mm_set1_ps(gravityY);
+
+    for (; x + 4 <= end; x += 4)
+    {
+        __m128 inverse4 = _mm_loadu_ps(inverse + x);
+        __m128 movable = _mm_cmpgt_ps(inverse4, zero4);
+
+        __m128 accelerationX = _mm_and_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(fx + x), inverse4), gx4), movable);
+        __m128 accelerationY = _mm_and_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(fy + x), inverse4), gy4), movable);
+
+        __m128 velocityX = _mm_loadu_ps(vx + x);
+        __m128 velocityY = _mm_loadu_ps(vy + x);
+
+        _mm_storeu_ps(px + x, _mm_add_ps(_mm_loadu_ps(px + x), _mm_mul_ps(_mm_add_ps(velocityX, _mm_mul_ps(accelerationX, half4)), dt4)));
+        _mm_storeu_ps(py + x, _mm_add_ps(_mm_loadu_ps(py + x), _mm_mul_ps(_mm_add_ps(velocityY, _mm_mul_ps(accelerationY, half4)), dt4)));
+        _mm_storeu_ps(vx + x, _mm_add_ps(velocityX, _mm_mul_ps(accelerationX, dt4)));
+        _mm_storeu_ps(vy + x, _mm_add_ps(velocityY, _mm_mul_ps(accelerationY, dt4)));
+        _mm_storeu_ps(fx + x, zero4);
+        _mm_storeu_ps(fy + x, zero4);
+    }
+#endif
+
+    for (; x < end; x++)
+    {
+        float accelerationX = (inverse[x] > 0) ? fx[x] * inverse[x] + gravityX : 0;
+        float accelerationY = (inverse[x] > 0) ? fy[x] * inverse[x] + gravityY : 0;
+
+        px[x] += (vx[x] + accelerationX * half) * deltaTime;
+        py[x] += (vy[x] + accelerationY * half) * deltaTime;
+        vx[x] += accelerationX * deltaTime;
+        vy[x] += accelerationY * deltaTime;
+        fx[x] = 0;
+        fy[x] = 0;
+    }
+}
+
+void CacoEngine::BodyStore::IntegrateRange(int begin, int end, float deltaTime)
+{
+    if (this->Scheme == IntegrationScheme::VelocityVerlet)
+        this->IntegrateVerlet(begin, end, deltaTime);
+    else
+        this->IntegrateEuler(begin, end, deltaTime);
+}
+
+void CacoEngine::BodyStore::Integrate(float deltaTime)
+{
+    this->IntegrateRange(0, this->Count, deltaTime);
+}
+
+void CacoEngine::BodyStore::Integrate(float deltaTime, ThreadPool& pool)
+{
+    // A multiple of 8 so every chunk but the last runs entirely in the vector loop
+    pool.ParallelFor(this->Count, 16384, [&](int begin, int end, int thread)
+    {
+        this->IntegrateRange(begin, end, deltaTime);
+    });
+}
+
+#if defined(__AVX2__)
+// Q16.16 product of every lane: 64-bit products of the even and odd lanes, shifted back down.
+// A logical shift keeps the same low 32 bits as the arithmetic one of the scalar path.
+static inline __m256i MultiplyFixed(__m256i a, __m256i b)
+{
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, b), CacoEngine::Fixed::FractionBits);
+    __m256i odd = _mm256_srli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)), CacoEngine::Fixed::FractionBits);
+
+    return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+}
+#elif defined(__SSE4_1__)
+static inline __m128i MultiplyFixed(__m128i a, __m128i b)
+{
+    __m128i even = _mm_srli_epi64(_mm_mul_epi32(a, b), CacoEngine::Fixed::FractionBits);
+    __m128i odd = _mm_srli_epi64(_mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)), CacoEngine::Fixed::FractionBits);
+
+    return _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xCC);
+}
+#endif
+
+CacoEngine::FixedBodyStore::FixedBodyStore(int capacity) : Count(0), Scheme(IntegrationScheme::SemiImplicitEuler), Gravity(FixedVector2())
+{
+    capacity = std::max(capacity, 0);
+
+    this->PositionX.reserve(capacity);
+    this->PositionY.reserve(capacity);
+    this->VelocityX.reserve(capacity);
+    this->VelocityY.reserve(capacity);
+    this->ForceX.reserve(capacity);
+    this->ForceY.reserve(capacity);
+    this->InverseMass.reserve(capacity);
+}
+
+CacoEngine::FixedBodyStore::~FixedBodyStore()
+{
+}
+
+int CacoEngine::FixedBodyStore::Add(FixedVector2 position, FixedVector2 velocity, Fixed mass)
+{
+    int index = this->Count;
+
+    this->Resize(this->Count + 1);
+
+    this->SetPosition(index, position);
+    this->SetVelocity(index, velocity);
+    this->SetMass(index, mass);
+
+    return index;
+}
+
+void CacoEngine::FixedBodyStore::Remove(int index)
+{
+    int last = this->Count - 1;
+
+    this->PositionX[index] = this->PositionX[last];
+    this->PositionY[index] = this->PositionY[last];
+    this->VelocityX[index] = this->VelocityX[last];
+    this->VelocityY[index] = this->VelocityY[last];
+    this->ForceX[index] = this->ForceX[last];
+    this->ForceY[index] = this->ForceY[last];
+    this->InverseMass[index] = this->InverseMass[last];
+
+    this->Resize(last);
+}
+
+void CacoEngine::FixedBodyStore::Resize(int count)
+{
+    this->Count = std::max(count, 0);
+
+    this->PositionX.resize(this->Count, 0);
+    this->PositionY.resize(this->Count, 0);
+    this->VelocityX.resize(this->Count, 0);
+    this->VelocityY.resize(this->Count, 0);
+    this->ForceX.resize(this->Count, 0);
+    this->ForceY.resize(this->Count, 0);
+    this->InverseMass.resize(this->Count, Fixed::One);
+}
+
+void CacoEngine::FixedBodyStore::Clear()
+{
+    this->Resize(0);
+}
+
+int CacoEngine::FixedBodyStore::GetCount()
+{
+    return this->Count;
+}
+
+CacoEngine::FixedVector2 CacoEngine::FixedBodyStore::GetPosition(int index)
+{
+    return FixedVector2(Fixed::FromRaw(this->PositionX[index]), Fixed::FromRaw(this->PositionY[index]));
+}
+
+void CacoEngine::FixedBodyStore::SetPosition(int index, FixedVector2 position)
+{
+    this->PositionX[index] = position.X.Raw;
+    this->PositionY[index] = position.Y.Raw;
+}
+
+CacoEngine::FixedVector2 CacoEngine::FixedBodyStore::GetVelocity(int index)
+{
+    return FixedVector2(Fixed::FromRaw(this->VelocityX[index]), Fixed::FromRaw(this->VelocityY[index]));
+}
+
+void CacoEngine::FixedBodyStore::SetVelocity(int index, FixedVector2 velocity)
+{
+    this->VelocityX[index] = velocity.X.Raw;
+    this->VelocityY[index] = velocity.Y.Raw;
+}
+
+CacoEngine::Fixed CacoEngine::FixedBodyStore::GetInverseMass(int index)
+{
+    return Fixed::FromRaw(this->InverseMass[index]);
+}
+
+void CacoEngine::FixedBodyStore::SetMass(int index, Fixed mass)
+{
+    this->InverseMass[index] = (mass.Raw > 0) ? (Fixed(1) / mass).Raw : 0;
+}
+
+void CacoEngine::FixedBodyStore::AddForce(int index, FixedVector2 force)
+{
+    this->ForceX[index] = (Fixed::FromRaw(this->ForceX[index]) + force.X).Raw;
+    this->ForceY[index] = (Fixed::FromRaw(this->ForceY[index]) + force.Y).Raw;
+}
+
+void CacoEngine::FixedBodyStore::SetForce(int index, FixedVector2 force)
+{
+    this->ForceX[index] = force.X.Raw;
+    this->ForceY[index] = force.Y.Raw;
+}
+
+void CacoEngine::FixedBodyStore::IntegrateEuler(int begin, int end, Fixed deltaTime)
+{
+    Fixed gravityX = this->Gravity.X, gravityY = this->Gravity.Y;
+
+    int32_t* px = this->PositionX.data();
+    int32_t* py = this->PositionY.data();
+    int32_t* vx = this->VelocityX.data();
+    int32_t* vy = this->VelocityY.data();
+    int32_t* fx = this->ForceX.data();
+    int32_t* fy = this->ForceY.data();
+    int32_t* inverse = this->InverseMass.data();
+
+    int x = begin;
+
+#if defined(__AVX2__)
+    __m256i dt8 = _mm256_set1_epi32(deltaTime.Raw), zero8 = _mm256_setzero_si256();
+    __m256i gx8 = _mm256_set1_epi32(gravityX.Raw), gy8 = _mm256_set1_epi32(gravityY.Raw);
+
+    for (; x + 8 <= end; x += 8)
+    {
+        __m256i inverse8 = _mm256_loadu_si256((__m256i*)(inverse + x));
+        __m256i movable = _mm256_cmpgt_epi32(inverse8, zero8);
+
+        __m256i accelerationX = _mm256_and_si256(_mm256_add_epi32(MultiplyFixed(_mm256_loadu_si256((__m256i*)(fx + x)), inverse8), gx8), movable);
+        __m256i accelerationY = _mm256_and_si256(_mm256_add_epi32(MultiplyFixed(_mm256_loadu_si256((__m256i*)(fy + x)), inverse8), gy8), movable);
+
+        __m256i velocityX = _mm256_add_epi32(_mm256_loadu_si256((__m256i*)(vx + x)), MultiplyFixed(accelerationX, dt8));
+        __m256i velocityY = _mm256_add_epi32(_mm256_loadu_si256((__m256i*)(vy + x)), MultiplyFixed(accelerationY, dt8));
+
+        _mm256_storeu_si256((__m256i*)(vx + x), velocityX);
+        _mm256_storeu_si256((__m256i*)(vy + x), velocityY);
+        _mm256_storeu_si256((__m256i*)(px + x), _mm256_add_epi32(_mm256_loadu_si256((__m256i*)(px + x)), MultiplyFixed(velocityX, dt8)));
+        _mm256_storeu_si256((__m256i*)(py + x), _mm256_add_epi32(_mm256_loadu_si256((__m256i*)(py + x)), MultiplyFixed(velocityY, dt8)));
+        _mm256_storeu_si256((__m256i*)(fx + x), zero8);
+        _mm256_storeu_si256((__m256i*)(fy + x), zero8);
+    }
+#elif defined(__SSE4_1__)
+    __m128i dt4 = _mm_set1_epi32(deltaTime.Raw), zero4 = _mm_setzero_si128();
+    __m128i gx4 = _mm_set1_epi32(gravityX.Raw), gy4 = _mm_set1_epi32(gravityY.Raw);
+
+    for (; x + 4 <= end; x += 4)
+    {
+        __m128i inverse4 = _mm_loadu_si128((__m128i*)(inverse + x));
+        __m128i movable = _mm_cmpgt_epi32(inverse4, zero4);
+
+        __m128i accelerationX = _mm_and_si128(_mm_add_epi32(MultiplyFixed(_mm_loadu_si128((__m128i*)(fx + x)), inverse4), gx4), movable);
+        __m128i accelerationY = _mm_and_si128(_mm_add_epi32(MultiplyFixed(_mm_loadu_si128((__m128i*)(fy + x)), inverse4), gy4), movable);
+
+        __m128i velocityX = _mm_add_epi32(_mm_loadu_si128((__m128i*)(vx + x)), MultiplyFixed(accelerationX, dt4));
+        __m128i velocityY = _mm_add_epi32(_mm_loadu_si128((__m128i*)(vy + x)), MultiplyFixed(accelerationY, dt4));
+
+        _mm_storeu_si128((__m128i*)(vx + x), velocityX);
+        _mm_storeu_si128((__m128i*)(vy + x), velocityY);
+        _mm_storeu_si128((__m128i*)(px + x), _mm_add_epi32(_mm_loadu_si128((__m128i*)(px + x)), MultiplyFixed(velocityX, dt4)));
+        _mm_storeu_si128((__m128i*)(py + x), _mm_add_epi32(_mm_loadu_si128((__m128i*)(py + x)), MultiplyFixed(velocityY, dt4)));
+        _mm_storeu_si128((__m128i*)(fx + x), zero4);
+        _mm_storeu_si128((__m128i*)(fy + x), zero4);
+    }
+#endif
+
+    // Scalar tail, and the whole range on targets without SSE4.1
+    for (; x < end; x++)
+    {
+        Fixed scale = Fixed::FromRaw(inverse[x]);
+
+        Fixed accelerationX = (inverse[x] > 0) ? Fixed::FromRaw(fx[x]) * scale + gravityX : Fixed();
+        Fixed accelerationY = (inverse[x] > 0) ? Fixed::FromRaw(fy[x]) * scale + gravityY : Fixed();
+
+        Fixed velocityX = Fixed::FromRaw(vx[x]) + accelerationX * deltaTime;
+        Fixed velocityY = Fixed::FromRaw(vy[x]) + accelerationY * deltaTime;
+
+        vx[x] = velocityX.Raw;
+        vy[x] = velocityY.Raw;
+        px[x] = (Fixed::FromRaw(px[x]) + velocityX * deltaTime).Raw;
+        py[x] = (Fixed::FromRaw(py[x]) + velocityY * deltaTime).Raw;
+        fx[x] = 0;
+        fy[x] = 0;
+    }
+}
+
+void CacoEngine::FixedBodyStore::IntegrateVerlet(int begin, int end, Fixed deltaTime)
+{
+    Fixed gravityX = this->Gravity.X, gravityY = this->Gravity.Y;
+    Fixed half = Fixed::FromRaw(deltaTime.Raw >> 1);
+
+    int32_t* px = this->PositionX.data();
+    int32_t* py = this->PositionY.data();
+    int32_t* vx = this->VelocityX.data();
+    int32_t* vy = this->VelocityY.data();
+    int32_t* fx = this->ForceX.data();
+    int32_t* fy = this->ForceY.data();
+    int32_t* inverse = this->InverseMass.data();
+
+    int x = begin;
+
+#if defined(__AVX2__)
+    __m256i dt8 = _mm256_set1_epi32(deltaTime.Raw), half8 = _mm256_set1_epi32(half.Raw), zero8 = _mm256_setzero_si256();
+    __m256i gx8 = _mm256_set1_epi32(gravityX.Raw), gy8 = _mm256_set1_epi32(gravityY.Raw);
+
+    for (; x + 8 <= end; x += 8)
+    {
+        __m256i inverse8 = _mm256_loadu_si256((__m256i*)(inverse + x));
+        __m256i movable = _mm256_cmpgt_epi32(inverse8, zero8);
+
+        __m256i accelerationX = _mm256_and_si256(_mm256_add_epi32(MultiplyFixed(_mm256_loadu_si256((__m256i*)(fx + x)), inverse8), gx8), movable);
+        __m256i accelerationY = _mm256_and_si256(_mm256_add_epi32(MultiplyFixed(_mm256_loadu_si256((__m256i*)(fy + x)), inverse8), gy8), movable);
+
+        __m256i velocityX = _mm256_loadu_si256((__m256i*)(vx + x));
+        __m256i velocityY = _mm256_loadu_si256((__m256i*)(vy + x));
+
+        // p += (v + a * dt / 2) * dt
+        _mm256_storeu_si256((__m256i*)(px + x), _mm256_add_epi32(_mm256_loadu_si256((__m256i*)(px + x)), MultiplyFixed(_mm256_add_epi32(velocityX, MultiplyFixed(accelerationX, half8)), dt8)));
+        _mm256_storeu_si256((__m256i*)(py + x), _mm256_add_epi32(_mm256_loadu_si256((__m256i*)(py + x)), MultiplyFixed(_mm256_add_epi32(velocityY, MultiplyFixed(accelerationY, half8)), dt8)));
+        _mm256_storeu_si256((__m256i*)(vx + x), _mm256_add_epi32(velocityX, MultiplyFixed(accelerationX, dt8)));
+        _mm256_storeu_si256((__m256i*)(vy + x), _mm256_add_epi32(velocityY, MultiplyFixed(accelerationY, dt8)));
+        _mm256_storeu_si256((__m256i*)(fx + x), zero8);
+        _mm256_storeu_si256((__m256i*)(fy + x), zero8);
+    }
+#elif defined(__SSE4_1__)
+    __m128i dt4 = _mm_set1_epi32(deltaTime.Raw), half4 = _mm_set1_epi32(half.Raw), zero4 = _mm_setzero_si128();
+    __m128i gx4 = _mm_set1_epi32(gravityX.Raw), gy4 = _mm_set1_epi32(gravityY.Raw);
+
+    for (; x + 4 <= end; x += 4)
+    {
+        __m128i inverse4 = _mm_loadu_si128((__m128i*)(inverse + x));
+        __m128i movable = _mm_cmpgt_epi32(inverse4, zero4);
+
+        __m128i accelerationX = _mm_and_si128(_mm_add_epi32(MultiplyFixed(_mm_loadu_si128((__m128i*)(fx + x)), inverse4), gx4), movable);
+        __m128i accelerationY = _mm_and_si128(_mm_add_epi32(MultiplyFixed(_mm_loadu_si128((__m128i*)(fy + x)), inverse4), gy4), movable);
+
+        __m128i velocityX = _mm_loadu_si128((__m128i*)(vx + x));
+        __m128i velocityY = _mm_loadu_si128((__m128i*)(vy + x));
+
+        _mm_storeu_si128((__m128i*)(px + x), _mm_add_epi32(_mm_loadu_si128((__m128i*)(px + x)), MultiplyFixed(_mm_add_epi32(velocityX, MultiplyFixed(accelerationX, half4)), dt4)));
+        _mm_storeu_si128((__m128i*)(py + x), _mm_add_epi32(_mm_loadu_si128((__m128i*)(py + x)), MultiplyFixed(_mm_add_epi32(velocityY, MultiplyFixed(accelerationY, half4)), dt4)));
+        _mm_storeu_si128((__m128i*)(vx + x), _mm_add_epi32(velocityX, MultiplyFixed(accelerationX, dt4)));
+        _mm_storeu_si128((__m128i*)(vy + x), _mm_add_epi32(velocityY, MultiplyFixed(accelerationY, dt4)));
+        _mm_storeu_si128((__m128i*)(fx + x), zero4);
+        _mm_storeu_si128((__m128i*)(fy + x), zero4);
+    }
+#endif
+
+    for (; x < end; x++)
+    {
+        Fixed scale = Fixed::FromRaw(inverse[x]);
+
+        Fixed accelerationX = (inverse[x] > 0) ? Fixed::FromRaw(fx[x]) * scale + gravityX : Fixed();
+        Fixed accelerationY = (inverse[x] > 0) ? Fixed::FromRaw(fy[x]) * scale + gravityY : Fixed();
+
+        Fixed velocityX = Fixed::FromRaw(vx[x]), velocityY = Fixed::FromRaw(vy[x]);
+
+        px[x] = (Fixed::FromRaw(px[x]) + (velocityX + accelerationX * half) * deltaTime).Raw;
+        py[x] = (Fixed::FromRaw(py[x]) + (velocityY + accelerationY * half) * deltaTime).Raw;
+        vx[x] = (velocityX + accelerationX * deltaTime).Raw;
+        vy[x] = (velocityY + accelerationY * deltaTime).Raw;
+        fx[x] = 0;
+        fy[x] = 0;
+    }
+}
+
+void CacoEngine::FixedBodyStore::IntegrateRange(int begin, int end, Fixed deltaTime)
+{
+    if (this->Scheme == IntegrationScheme::VelocityVerlet)
+        this->IntegrateVerlet(begin, end, deltaTime);
+    else
+        this->IntegrateEuler(begin, end, deltaTime);
+}
+
+void CacoEngine::FixedBodyStore::Integrate(Fixed deltaTime)
+{
+    this->IntegrateRange(0, this->Count, deltaTime);
+}
+
+void CacoEngine::FixedBodyStore::Integrate(Fixed deltaTime, ThreadPool& pool)
+{
+    pool.ParallelFor(this->Count, 16384, [&](int begin, int end, int thread)
+    {
+        this->IntegrateRange(begin, end, deltaTime);
+    });
+}
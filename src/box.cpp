@@ -3,9 +3,15 @@
 
 CacoEngine::Box2D::Box2D(Vector2Df dimensions, Vector2Df position, RGBA color) : RigidObject2D()
 {
+    this->Position = position;
     this->ObjectMesh = Rectangle(dimensions, position, color).ObjectMesh;
 }
 
+int CacoEngine::Box2D::AddShape(Narrowphase& narrowphase)
+{
+    return narrowphase.AddBox(this->GetBounds());
+}
+
 CacoEngine::Box2D::~Box2D()
 {
 }
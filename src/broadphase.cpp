@@ -0,0 +1,750 @@
+#include "broadphase.hpp"
+#include <algorithm>
+#include <cmath>
+
+CacoEngine::BroadphasePair::BroadphasePair(int a, int b) : A(a), B(b) {}
+
+bool CacoEngine::BroadphasePair::operator ==(const BroadphasePair& pair) const
+{
+    return this->A == pair.A && this->B == pair.B;
+}
+
+bool CacoEngine::BroadphasePair::operator <(const BroadphasePair& pair) const
+{
+    return (this->A != pair.A) ? this->A < pair.A : this->B < pair.B;
+}
+
+CacoEngine::Broadphase::~Broadphase() {}
+
+void CacoEngine::Broadphase::SetProxyFilter(int proxy, uint32_t category, uint32_t mask)
+{
+    if (proxy >= this->Categories.size())
+    {
+        // Only worth storing once it differs from the default
+        if (category == 1 && mask == 0xFFFFFFFF)
+            return;
+
+        this->Categories.resize(proxy + 1, 1);
+        this->Masks.resize(proxy + 1, 0xFFFFFFFF);
+    }
+
+    this->Categories[proxy] = category;
+    this->Masks[proxy] = mask;
+}
+
+bool CacoEngine::Broadphase::CanPair(int a, int b) const
+{
+    uint32_t categoryA = 1, maskA = 0xFFFFFFFF, categoryB = 1, maskB = 0xFFFFFFFF;
+
+    if (a < this->Categories.size())
+    {
+        categoryA = this->Categories[a];
+        maskA = this->Masks[a];
+    }
+
+    if (b < this->Categories.size())
+    {
+        categoryB = this->Categories[b];
+        maskB = this->Masks[b];
+    }
+
+    return (categoryA & maskB) && (categoryB & maskA);
+}
+
+void CacoEngine::Broadphase::AddActive(int proxy)
+{
+    if (proxy >= this->ActiveSlots.size())
+    {
+        this->ActiveSlots.resize(proxy + 1, -1);
+        this->Resting.resize(proxy + 1, 0);
+    }
+
+    this->Resting[proxy] = 0;
+
+    if (this->ActiveSlots[proxy] >= 0)
+        return;
+
+    this->ActiveSlots[proxy] = this->ActiveProxies.size();
+    this->ActiveProxies.push_back(proxy);
+}
+
+void CacoEngine::Broadphase::RemoveActive(int proxy)
+{
+    if (proxy < 0 || proxy >= this->ActiveSlots.size() || this->ActiveSlots[proxy] < 0)
+        return;
+
+    // Swap-remove, the last active proxy takes over the slot
+    int slot = this->ActiveSlots[proxy], last = this->ActiveProxies.back();
+
+    this->ActiveProxies[slot] = last;
+    this->ActiveSlots[last] = slot;
+
+    this->ActiveProxies.pop_back();
+    this->ActiveSlots[proxy] = -1;
+}
+
+void CacoEngine::Broadphase::SetProxyResting(int proxy, bool resting)
+{
+    if (proxy < 0 || this->IsProxyResting(proxy) == resting)
+        return;
+
+    if (resting)
+    {
+        this->RemoveActive(proxy);
+        this->Resting[proxy] = 1;
+    }
+    else
+        this->AddActive(proxy);
+}
+
+bool CacoEngine::Broadphase::IsProxyResting(int proxy) const
+{
+    return proxy >= 0 && proxy < this->Resting.size() && this->Resting[proxy];
+}
+
+void CacoEngine::Broadphase::FindPairs(std::vector<BroadphasePair>& pairs, ThreadPool& pool)
+{
+    this->FindPairs(pairs);
+}
+
+CacoEngine::SpatialHashBroadphase::SpatialHashBroadphase(float cellSize) : ProxyCount(0), CellSize(cellSize), ActiveCellSize(1), RestingDirty(false) {}
+
+CacoEngine::SpatialHashBroadphase::~SpatialHashBroadphase() {}
+
+int CacoEngine::SpatialHashBroadphase::CreateProxy(const AABB& bounds)
+{
+    int proxy;
+
+    if (!this->FreeProxies.empty())
+    {
+        proxy = this->FreeProxies.back();
+        this->FreeProxies.pop_back();
+    }
+    else
+    {
+        proxy = this->Bounds.size();
+
+        this->Bounds.emplace_back();
+        this->Alive.push_back(0);
+    }
+
+    this->Bounds[proxy] = bounds;
+    this->Alive[proxy] = 1;
+    this->ProxyCount++;
+
+    this->SetProxyFilter(proxy, 1, 0xFFFFFFFF);
+    this->AddActive(proxy);
+
+    return proxy;
+}
+
+void CacoEngine::SpatialHashBroadphase::DestroyProxy(int proxy)
+{
+    if (proxy < 0 || proxy >= this->Alive.size() || !this->Alive[proxy])
+        return;
+
+    if (this->IsProxyResting(proxy))
+        this->RestingDirty = true;
+
+    this->Alive[proxy] = 0;
+    this->FreeProxies.push_back(proxy);
+    this->ProxyCount--;
+
+    this->RemoveActive(proxy);
+    this->Resting[proxy] = 0;
+}
+
+void CacoEngine::SpatialHashBroadphase::MoveProxy(int proxy, const AABB& bounds)
+{
+    if (proxy < 0 || proxy >= this->Bounds.size())
+        return;
+
+    this->Bounds[proxy] = bounds;
+
+    if (this->IsProxyResting(proxy))
+        this->RestingDirty = true;
+}
+
+void CacoEngine::SpatialHashBroadphase::SetProxyResting(int proxy, bool resting)
+{
+    if (proxy < 0 || proxy >= this->Alive.size() || !this->Alive[proxy] || this->IsProxyResting(proxy) == resting)
+        return;
+
+    Broadphase::SetProxyResting(proxy, resting);
+
+    this->RestingDirty = true;
+}
+
+void CacoEngine::SpatialHashBroadphase::QueryRegion(const AABB& region, std::vector<int>& proxies)
+{
+    // Queries are rare next to FindPairs, a linear scan avoids keeping the grid valid between ticks
+    for (int x = 0; x < this->Bounds.size(); x++)
+        if (this->Alive[x] && this->Bounds[x].Overlaps(region))
+            proxies.push_back(x);
+}
+
+void CacoEngine::SpatialHashBroadphase::QueryRay(Point2Df start, Point2Df end, std::vector<int>& proxies)
+{
+    for (int x = 0; x < this->Bounds.size(); x++)
+        if (this->Alive[x] && this->Bounds[x].IntersectsSegment(start, end))
+            proxies.push_back(x);
+}
+
+void CacoEngine::SpatialHashBroadphase::Clear()
+{
+    this->Bounds.clear();
+    this->Alive.clear();
+    this->FreeProxies.clear();
+    this->ProxyCount = 0;
+
+    this->ActiveProxies.clear();
+    this->ActiveSlots.clear();
+    this->Resting.clear();
+
+    this->RestingDirty = true;
+}
+
+int CacoEngine::SpatialHashBroadphase::GetProxyCount()
+{
+    return this->ProxyCount;
+}
+
+void CacoEngine::SpatialHashBroadphase::SetCellSize(float cellSize)
+{
+    this->CellSize = cellSize;
+    this->RestingDirty = true;
+}
+
+float CacoEngine::SpatialHashBroadphase::GetCellSize()
+{
+    return (this->CellSize > 0) ? this->CellSize : this->ActiveCellSize;
+}
+
+uint32_t CacoEngine::SpatialHashBroadphase::Hash(int32_t x, int32_t y, uint32_t mask)
+{
+    return (((uint32_t)x * 73856093u) ^ ((uint32_t)y * 19349663u)) & mask;
+}
+
+void CacoEngine::SpatialHashBroadphase::GetCells(const AABB& bounds, int32_t& x0, int32_t& y0, int32_t& x1, int32_t& y1)
+{
+    float inverse = 1.0f / this->ActiveCellSize;
+
+    x0 = (int32_t)std::floor(bounds.MinX * inverse);
+    y0 = (int32_t)std::floor(bounds.MinY * inverse);
+    x1 = (int32_t)std::floor(bounds.MaxX * inverse);
+    y1 = (int32_t)std::floor(bounds.MaxY * inverse);
+}
+
+void CacoEngine::SpatialHashBroadphase::BuildTable(const std::vector<int>& proxies, std::vector<uint32_t>& start, std::vector<CellEntry>& entries,
+                                                   std::vector<int>& large, std::vector<int>* small)
+{
+    large.clear();
+
+    if (small)
+        small->clear();
+
+    uint32_t total = 0;
+
+    for (int x = 0; x < proxies.size(); x++)
+    {
+        int proxy = proxies[x];
+
+        int32_t x0, y0, x1, y1;
+
+        this->GetCells(this->Bounds[proxy], x0, y0, x1, y1);
+
+        this->FirstCellX[proxy] = x0;
+        this->FirstCellY[proxy] = y0;
+
+        int64_t cells = (int64_t)(x1 - x0 + 1) * (y1 - y0 + 1);
+
+        if (cells > MaxCellsPerProxy)
+        {
+            this->Alive[proxy] = 2;
+            large.push_back(proxy);
+        }
+        else
+        {
+            this->Alive[proxy] = 1;
+            total += cells;
+
+            if (small)
+                small->push_back(proxy);
+        }
+    }
+
+    uint32_t tableSize = 16;
+
+    while (tableSize < total * 2)
+        tableSize <<= 1;
+
+    uint32_t mask = tableSize - 1;
+
+    // Counting sort of (cell, proxy) entries by bucket: count, prefix sum, then place back to front
+    start.assign(tableSize + 1, 0);
+    entries.resize(total);
+
+    for (int x = 0; x < proxies.size(); x++)
+    {
+        int proxy = proxies[x];
+
+        if (this->Alive[proxy] != 1)
+            continue;
+
+        int32_t x0, y0, x1, y1;
+
+        this->GetCells(this->Bounds[proxy], x0, y0, x1, y1);
+
+        for (int32_t cy = y0; cy <= y1; cy++)
+            for (int32_t cx = x0; cx <= x1; cx++)
+                start[this->Hash(cx, cy, mask)]++;
+    }
+
+    for (uint32_t x = 1; x < tableSize; x++)
+        start[x] += start[x - 1];
+
+    start[tableSize] = total;
+
+    for (int x = 0; x < proxies.size(); x++)
+    {
+        int proxy = proxies[x];
+
+        if (this->Alive[proxy] != 1)
+            continue;
+
+        int32_t x0, y0, x1, y1;
+
+        this->GetCells(this->Bounds[proxy], x0, y0, x1, y1);
+
+        for (int32_t cy = y0; cy <= y1; cy++)
+            for (int32_t cx = x0; cx <= x1; cx++)
+                entries[--start[this->Hash(cx, cy, mask)]] = CellEntry { cx, cy, proxy };
+    }
+}
+
+void CacoEngine::SpatialHashBroadphase::Rebuild()
+{
+    int proxies = this->Bounds.size();
+    bool resting = this->ActiveProxies.size() < this->ProxyCount;
+
+    // Cells roughly the size of a typical proxy keep both the cells per proxy and the proxies per cell low.
+    // The resting table depends on the size, so while it holds proxies the size only changes with it.
+    float cellSize = this->ActiveCellSize;
+
+    if (this->CellSize > 0)
+        cellSize = this->CellSize;
+    else if (this->ProxyCount > 0 && (this->RestingDirty || !resting))
+    {
+        double extent = 0;
+
+        for (int x = 0; x < proxies; x++)
+            if (this->Alive[x])
+                extent += std::max(this->Bounds[x].MaxX - this->Bounds[x].MinX, this->Bounds[x].MaxY - this->Bounds[x].MinY);
+
+        cellSize = std::max(extent / this->ProxyCount, 1e-3);
+    }
+
+    if (cellSize != this->ActiveCellSize)
+    {
+        this->ActiveCellSize = cellSize;
+        this->RestingDirty = true;
+    }
+
+    this->FirstCellX.resize(proxies);
+    this->FirstCellY.resize(proxies);
+
+    if (this->RestingDirty)
+    {
+        std::vector<int> restingProxies;
+
+        for (int x = 0; x < proxies; x++)
+            if (this->Alive[x] && this->IsProxyResting(x))
+                restingProxies.push_back(x);
+
+        this->BuildTable(restingProxies, this->RestingStart, this->RestingEntries, this->RestingLarge, &this->RestingProxies);
+
+        this->RestingDirty = false;
+    }
+
+    this->BuildTable(this->ActiveProxies, this->BucketStart, this->Entries, this->LargeProxies, nullptr);
+}
+
+void CacoEngine::SpatialHashBroadphase::TestPair(int a, int b, std::vector<BroadphasePair>& pairs)
+{
+    if (this->CanPair(a, b) && this->Bounds[a].Overlaps(this->Bounds[b]))
+        pairs.emplace_back(std::min(a, b), std::max(a, b));
+}
+
+void CacoEngine::SpatialHashBroadphase::CollectPairs(int firstBucket, int lastBucket, std::vector<BroadphasePair>& pairs)
+{
+    for (int b = firstBucket; b < lastBucket; b++)
+    {
+        uint32_t start = this->BucketStart[b], end = this->BucketStart[b + 1];
+
+        for (uint32_t x = start; x < end; x++)
+        {
+            CellEntry& first = this->Entries[x];
+
+            for (uint32_t y = x + 1; y < end; y++)
+            {
+                CellEntry& second = this->Entries[y];
+
+                // Different cells that happen to share a bucket
+                if (first.CellX != second.CellX || first.CellY != second.CellY)
+                    continue;
+
+                int a = first.Proxy, c = second.Proxy;
+
+                // Proxies spanning several cells meet in each of them, only the first shared cell reports
+                if (std::max(this->FirstCellX[a], this->FirstCellX[c]) != first.CellX ||
+                    std::max(this->FirstCellY[a], this->FirstCellY[c]) != first.CellY)
+                    continue;
+
+                this->TestPair(a, c, pairs);
+            }
+        }
+    }
+}
+
+void CacoEngine::SpatialHashBroadphase::ProbeResting(int proxy, int32_t x0, int32_t y0, int32_t x1, int32_t y1, std::vector<BroadphasePair>& pairs)
+{
+    uint32_t mask = this->RestingStart.size() - 2;
+
+    for (int32_t cy = y0; cy <= y1; cy++)
+        for (int32_t cx = x0; cx <= x1; cx++)
+        {
+            uint32_t bucket = this->Hash(cx, cy, mask);
+
+            for (uint32_t x = this->RestingStart[bucket]; x < this->RestingStart[bucket + 1]; x++)
+            {
+                CellEntry& entry = this->RestingEntries[x];
+
+                if (entry.CellX != cx || entry.CellY != cy)
+                    continue;
+
+                if (std::max(this->FirstCellX[proxy], this->FirstCellX[entry.Proxy]) != cx ||
+                    std::max(this->FirstCellY[proxy], this->FirstCellY[entry.Proxy]) != cy)
+                    continue;
+
+                this->TestPair(proxy, entry.Proxy, pairs);
+            }
+        }
+}
+
+void CacoEngine::SpatialHashBroadphase::CollectRestingPairs(int first, int last, std::vector<BroadphasePair>& pairs)
+{
+    if (this->RestingEntries.empty())
+        return;
+
+    for (int x = first; x < last; x++)
+    {
+        int proxy = this->ActiveProxies[x];
+
+        if (this->Alive[proxy] != 1)
+            continue;
+
+        int32_t x0, y0, x1, y1;
+
+        this->GetCells(this->Bounds[proxy], x0, y0, x1, y1);
+
+        this->ProbeResting(proxy, x0, y0, x1, y1, pairs);
+    }
+}
+
+void CacoEngine::SpatialHashBroadphase::CollectLargePairs(std::vector<BroadphasePair>& pairs)
+{
+    for (int x = 0; x < this->LargeProxies.size(); x++)
+    {
+        int large = this->LargeProxies[x];
+
+        for (int y = 0; y < this->ActiveProxies.size(); y++)
+        {
+            int other = this->ActiveProxies[y];
+
+            // Two large proxies are reported once, from the lower ID
+            if (other == large || (this->Alive[other] == 2 && other < large))
+                continue;
+
+            this->TestPair(large, other, pairs);
+        }
+
+        // Resting proxies through their table, unless scanning them is cheaper than its cells
+        int32_t x0, y0, x1, y1;
+
+        this->GetCells(this->Bounds[large], x0, y0, x1, y1);
+
+        if ((int64_t)(x1 - x0 + 1) * (y1 - y0 + 1) <= (int64_t)this->RestingProxies.size())
+            this->ProbeResting(large, x0, y0, x1, y1, pairs);
+        else
+            for (int y = 0; y < this->RestingProxies.size(); y++)
+                this->TestPair(large, this->RestingProxies[y], pairs);
+    }
+
+    for (int x = 0; x < this->RestingLarge.size(); x++)
+        for (int y = 0; y < this->ActiveProxies.size(); y++)
+            this->TestPair(this->RestingLarge[x], this->ActiveProxies[y], pairs);
+}
+
+void CacoEngine::SpatialHashBroadphase::FindPairs(std::vector<BroadphasePair>& pairs)
+{
+    pairs.clear();
+
+    this->Rebuild();
+
+    this->CollectPairs(0, this->BucketStart.size() - 1, pairs);
+    this->CollectRestingPairs(0, this->ActiveProxies.size(), pairs);
+    this->CollectLargePairs(pairs);
+}
+
+void CacoEngine::SpatialHashBroadphase::FindPairs(std::vector<BroadphasePair>& pairs, ThreadPool& pool)
+{
+    const int bucketsPerChunk = 4096, proxiesPerChunk = 1024;
+
+    pairs.clear();
+
+    this->Rebuild();
+
+    int buckets = this->BucketStart.size() - 1;
+
+    this->ChunkPairs.resize((buckets + bucketsPerChunk - 1) / bucketsPerChunk);
+
+    pool.ParallelFor(buckets, bucketsPerChunk, [this](int begin, int end, int thread)
+    {
+        std::vector<BroadphasePair>& chunk = this->ChunkPairs[begin / bucketsPerChunk];
+
+        chunk.clear();
+
+        this->CollectPairs(begin, end, chunk);
+    });
+
+    int active = this->ActiveProxies.size();
+
+    this->ChunkRestingPairs.resize((active + proxiesPerChunk - 1) / proxiesPerChunk);
+
+    pool.ParallelFor(active, proxiesPerChunk, [this](int begin, int end, int thread)
+    {
+        std::vector<BroadphasePair>& chunk = this->ChunkRestingPairs[begin / proxiesPerChunk];
+
+        chunk.clear();
+
+        this->CollectRestingPairs(begin, end, chunk);
+    });
+
+    // Concatenated in order, the same sequence a serial search produces
+    for (int x = 0; x < this->ChunkPairs.size(); x++)
+        pairs.insert(pairs.end(), this->ChunkPairs[x].begin(), this->ChunkPairs[x].end());
+
+    for (int x = 0; x < this->ChunkRestingPairs.size(); x++)
+        pairs.insert(pairs.end(), this->ChunkRestingPairs[x].begin(), this->ChunkRestingPairs[x].end());
+
+    this->CollectLargePairs(pairs);
+}
+
+CacoEngine::SweepAndPruneBroadphase::SweepAndPruneBroadphase() : ProxyCount(0), Swaps(0) {}
+
+CacoEngine::SweepAndPruneBroadphase::~SweepAndPruneBroadphase() {}
+
+int CacoEngine::SweepAndPruneBroadphase::CreateProxy(const AABB& bounds)
+{
+    int proxy;
+
+    if (!this->FreeProxies.empty())
+    {
+        proxy = this->FreeProxies.back();
+        this->FreeProxies.pop_back();
+    }
+    else
+    {
+        proxy = this->Bounds.size();
+
+        this->Bounds.emplace_back();
+        this->Alive.push_back(0);
+    }
+
+    this->Bounds[proxy] = bounds;
+    this->Alive[proxy] = 1;
+    this->ProxyCount++;
+
+    this->SetProxyFilter(proxy, 1, 0xFFFFFFFF);
+    this->AddActive(proxy);
+
+    // Appended at the end, the next sort moves them into place and picks up their pairs on the way
+    for (int axis = 0; axis < 2; axis++)
+    {
+        this->Endpoints[axis].push_back(Endpoint { (axis == 0) ? bounds.MinX : bounds.MinY, (uint32_t)proxy << 1 });
+        this->Endpoints[axis].push_back(Endpoint { (axis == 0) ? bounds.MaxX : bounds.MaxY, ((uint32_t)proxy << 1) | 1 });
+    }
+
+    return proxy;
+}
+
+void CacoEngine::SweepAndPruneBroadphase::DestroyProxy(int proxy)
+{
+    if (proxy < 0 || proxy >= this->Alive.size() || !this->Alive[proxy])
+        return;
+
+    // The ID is only recycled once its endpoints are gone
+    this->Alive[proxy] = 0;
+    this->PendingDestroy.push_back(proxy);
+    this->ProxyCount--;
+
+    this->RemoveActive(proxy);
+    this->Resting[proxy] = 0;
+}
+
+void CacoEngine::SweepAndPruneBroadphase::MoveProxy(int proxy, const AABB& bounds)
+{
+    if (proxy >= 0 && proxy < this->Bounds.size())
+        this->Bounds[proxy] = bounds;
+}
+
+void CacoEngine::SweepAndPruneBroadphase::QueryRegion(const AABB& region, std::vector<int>& proxies)
+{
+    // Bounds may have moved since the last sort, so the endpoint lists can't be searched
+    for (int x = 0; x < this->Bounds.size(); x++)
+        if (this->Alive[x] && this->Bounds[x].Overlaps(region))
+            proxies.push_back(x);
+}
+
+void CacoEngine::SweepAndPruneBroadphase::QueryRay(Point2Df start, Point2Df end, std::vector<int>& proxies)
+{
+    for (int x = 0; x < this->Bounds.size(); x++)
+        if (this->Alive[x] && this->Bounds[x].IntersectsSegment(start, end))
+            proxies.push_back(x);
+}
+
+void CacoEngine::SweepAndPruneBroadphase::Clear()
+{
+    this->Bounds.clear();
+    this->Alive.clear();
+    this->FreeProxies.clear();
+    this->PendingDestroy.clear();
+    this->Endpoints[0].clear();
+    this->Endpoints[1].clear();
+    this->Overlaps.clear();
+    this->ProxyCount = 0;
+
+    this->ActiveProxies.clear();
+    this->ActiveSlots.clear();
+    this->Resting.clear();
+}
+
+int CacoEngine::SweepAndPruneBroadphase::GetProxyCount()
+{
+    return this->ProxyCount;
+}
+
+uint64_t CacoEngine::SweepAndPruneBroadphase::GetSwapCount()
+{
+    return this->Swaps;
+}
+
+void CacoEngine::SweepAndPruneBroadphase::RemoveDestroyed()
+{
+    if (this->PendingDestroy.empty())
+        return;
+
+    std::vector<uint8_t>& alive = this->Alive;
+
+    for (int axis = 0; axis < 2; axis++)
+    {
+        std::vector<Endpoint>& endpoints = this->Endpoints[axis];
+
+        endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(), [&alive](const Endpoint& endpoint)
+        {
+            return !alive[endpoint.Data >> 1];
+        }), endpoints.end());
+    }
+
+    for (auto it = this->Overlaps.begin(); it != this->Overlaps.end();)
+    {
+        if (!alive[*it >> 32] || !alive[*it & 0xFFFFFFFF])
+            it = this->Overlaps.erase(it);
+        else
+            ++it;
+    }
+
+    this->FreeProxies.insert(this->FreeProxies.end(), this->PendingDestroy.begin(), this->PendingDestroy.end());
+    this->PendingDestroy.clear();
+}
+
+void CacoEngine::SweepAndPruneBroadphase::SortAxis(int axis)
+{
+    std::vector<Endpoint>& endpoints = this->Endpoints[axis];
+
+    // At equal values a min goes before a max, so touching boxes count as overlapping like AABB::Overlaps
+    auto less = [](const Endpoint& first, const Endpoint& second)
+    {
+        return first.Value < second.Value || (first.Value == second.Value && !(first.Data & 1) && (second.Data & 1));
+    };
+
+    for (int x = 1; x < endpoints.size(); x++)
+    {
+        Endpoint endpoint = endpoints[x];
+
+        int y = x - 1;
+
+        for (; y >= 0 && less(endpoint, endpoints[y]); y--)
+        {
+            Endpoint& passed = endpoints[y];
+
+            uint32_t a = endpoint.Data >> 1, b = passed.Data >> 1;
+
+            bool isMax = endpoint.Data & 1, passedMax = passed.Data & 1;
+
+            if (a != b)
+            {
+                uint64_t key = ((uint64_t)std::min(a, b) << 32) | std::max(a, b);
+
+                // A min moving below a max starts an overlap on this axis, the other way round ends one
+                if (!isMax && passedMax)
+                {
+                    if (this->Bounds[a].Overlaps(this->Bounds[b]))
+                        this->Overlaps.insert(key);
+                }
+                else if (isMax && !passedMax)
+                    this->Overlaps.erase(key);
+            }
+
+            endpoints[y + 1] = passed;
+
+            this->Swaps++;
+        }
+
+        endpoints[y + 1] = endpoint;
+    }
+}
+
+void CacoEngine::SweepAndPruneBroadphase::FindPairs(std::vector<BroadphasePair>& pairs)
+{
+    this->RemoveDestroyed();
+
+    this->Swaps = 0;
+
+    // Refresh endpoint values from the current bounds, the lists stay nearly sorted
+    for (int axis = 0; axis < 2; axis++)
+        for (Endpoint& endpoint : this->Endpoints[axis])
+        {
+            AABB& bounds = this->Bounds[endpoint.Data >> 1];
+
+            if (axis == 0)
+                endpoint.Value = (endpoint.Data & 1) ? bounds.MaxX : bounds.MinX;
+            else
+                endpoint.Value = (endpoint.Data & 1) ? bounds.MaxY : bounds.MinY;
+        }
+
+    this->SortAxis(0);
+    this->SortAxis(1);
+
+    pairs.clear();
+    pairs.reserve(this->Overlaps.size());
+
+    // Overlaps are tracked regardless of filters and resting, so changing either needs no re-sort
+    for (uint64_t key : this->Overlaps)
+    {
+        int a = (int)(key >> 32), b = (int)(key & 0xFFFFFFFF);
+
+        if (this->CanPair(a, b) && !(this->IsProxyResting(a) && this->IsProxyResting(b)))
+            pairs.emplace_back(a, b);
+    }
+}
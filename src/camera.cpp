@@ -0,0 +1,203 @@
+#include "camera.hpp"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+CacoEngine::CameraTransform::CameraTransform() : A(1), B(0), C(0), D(1), TX(0), TY(0) {}
+
+bool CacoEngine::CameraTransform::IsIdentity() const
+{
+    return this->A == 1 && this->B == 0 && this->C == 0 && this->D == 1 && this->TX == 0 && this->TY == 0;
+}
+
+CacoEngine::Point2Df CacoEngine::CameraTransform::Apply(Point2Df point) const
+{
+    return Point2Df(this->A * point.X + this->B * point.Y + this->TX,
+                    this->C * point.X + this->D * point.Y + this->TY);
+}
+
+CacoEngine::Point2Df CacoEngine::CameraTransform::Invert(Point2Df point) const
+{
+    float determinant = this->A * this->D - this->B * this->C;
+
+    if (determinant == 0)
+        return Point2Df();
+
+    float x = point.X - this->TX, y = point.Y - this->TY;
+
+    return Point2Df((this->D * x - this->B * y) / determinant,
+                    (this->A * y - this->C * x) / determinant);
+}
+
+bool CacoEngine::CameraTransform::operator ==(const CameraTransform& transform) const
+{
+    return this->A == transform.A && this->B == transform.B && this->C == transform.C && this->D == transform.D &&
+           this->TX == transform.TX && this->TY == transform.TY;
+}
+
+bool CacoEngine::CameraTransform::operator !=(const CameraTransform& transform) const
+{
+    return !(*this == transform);
+}
+
+void CacoEngine::TransformVertices(const CameraTransform& transform, const Vertex2Df* source, Vertex2Df* destination, int count)
+{
+    if (count <= 0)
+        return;
+
+    if (source != destination)
+        std::memcpy(destination, source, count * sizeof(Vertex2Df));
+
+    int x = 0;
+
+#if defined(__SSE2__)
+    // Two vertices per iteration, positions sit 20 bytes apart so each xy pair is loaded on its own
+    __m128 ac = _mm_setr_ps(transform.A, transform.C, transform.A, transform.C);
+    __m128 bd = _mm_setr_ps(transform.B, transform.D, transform.B, transform.D);
+    __m128 t = _mm_setr_ps(transform.TX, transform.TY, transform.TX, transform.TY);
+
+    for (; x + 2 <= count; x += 2)
+    {
+        __m64* first = reinterpret_cast<__m64*>(&destination[x].Position);
+        __m64* second = reinterpret_cast<__m64*>(&destination[x + 1].Position);
+
+        __m128 position = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), first), second);
+
+        __m128 xx = _mm_shuffle_ps(position, position, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 yy = _mm_shuffle_ps(position, position, _MM_SHUFFLE(3, 3, 1, 1));
+
+        position = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ac, xx), _mm_mul_ps(bd, yy)), t);
+
+        _mm_storel_pi(first, position);
+        _mm_storeh_pi(second, position);
+    }
+#endif
+
+    for (; x < count; x++)
+        destination[x].Position = transform.Apply(destination[x].Position);
+}
+
+void CacoEngine::TransformPoints(const CameraTransform& transform, SDL_FPoint* points, int count)
+{
+    int x = 0;
+
+#if defined(__AVX2__)
+    __m256 ac8 = _mm256_setr_ps(transform.A, transform.C, transform.A, transform.C, transform.A, transform.C, transform.A, transform.C);
+    __m256 bd8 = _mm256_setr_ps(transform.B, transform.D, transform.B, transform.D, transform.B, transform.D, transform.B, transform.D);
+    __m256 t8 = _mm256_setr_ps(transform.TX, transform.TY, transform.TX, transform.TY, transform.TX, transform.TY, transform.TX, transform.TY);
+
+    for (; x + 4 <= count; x += 4)
+    {
+        __m256 position = _mm256_loadu_ps(&points[x].x);
+
+        __m256 xx = _mm256_shuffle_ps(position, position, _MM_SHUFFLE(2, 2, 0, 0));
+        __m256 yy = _mm256_shuffle_ps(position, position, _MM_SHUFFLE(3, 3, 1, 1));
+
+        _mm256_storeu_ps(&points[x].x, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ac8, xx), _mm256_mul_ps(bd8, yy)), t8));
+    }
+#endif
+
+#if defined(__SSE2__)
+    __m128 ac = _mm_setr_ps(transform.A, transform.C, transform.A, transform.C);
+    __m128 bd = _mm_setr_ps(transform.B, transform.D, transform.B, transform.D);
+    __m128 t = _mm_setr_ps(transform.TX, transform.TY, transform.TX, transform.TY);
+
+    for (; x + 2 <= count; x += 2)
+    {
+        __m128 position = _mm_loadu_ps(&points[x].x);
+
+        __m128 xx = _mm_shuffle_ps(position, position, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 yy = _mm_shuffle_ps(position, position, _MM_SHUFFLE(3, 3, 1, 1));
+
+        _mm_storeu_ps(&points[x].x, _mm_add_ps(_mm_add_ps(_mm_mul_ps(ac, xx), _mm_mul_ps(bd, yy)), t));
+    }
+#endif
+
+    for (; x < count; x++)
+    {
+        Point2Df point = transform.Apply(Point2Df(points[x].x, points[x].y));
+
+        points[x].x = point.X;
+        points[x].y = point.Y;
+    }
+}
+
+CacoEngine::Camera::Camera(Vector2Df position, float zoom, float rotation)
+    : Position(position), Zoom(zoom), Rotation(rotation), Viewport(SDL_FRect { 0, 0, 1, 1 })
+{
+}
+
+SDL_Rect CacoEngine::Camera::GetViewportRect(Vector2D output) const
+{
+    return SDL_Rect {
+        (int)std::lround(this->Viewport.x * output.X),
+        (int)std::lround(this->Viewport.y * output.Y),
+        (int)std::lround(this->Viewport.w * output.X),
+        (int)std::lround(this->Viewport.h * output.Y)
+    };
+}
+
+CacoEngine::CameraTransform CacoEngine::Camera::GetTransform(Vector2D output) const
+{
+    SDL_Rect viewport = this->GetViewportRect(output);
+
+    CameraTransform transform;
+
+    float cosine = std::cos(this->Rotation), sine = std::sin(this->Rotation);
+
+    // Rotate the world by -Rotation around the camera, then scale
+    transform.A = this->Zoom * cosine;
+    transform.B = this->Zoom * sine;
+    transform.C = -this->Zoom * sine;
+    transform.D = this->Zoom * cosine;
+
+    // Camera position lands on the viewport center
+    transform.TX = viewport.w * 0.5f - (transform.A * this->Position.X + transform.B * this->Position.Y);
+    transform.TY = viewport.h * 0.5f - (transform.C * this->Position.X + transform.D * this->Position.Y);
+
+    return transform;
+}
+
+SDL_FRect CacoEngine::Camera::GetVisibleArea(Vector2D output) const
+{
+    SDL_Rect viewport = this->GetViewportRect(output);
+    CameraTransform transform = this->GetTransform(output);
+
+    Point2Df corners[4] = {
+        transform.Invert(Point2Df(0, 0)),
+        transform.Invert(Point2Df(viewport.w, 0)),
+        transform.Invert(Point2Df(viewport.w, viewport.h)),
+        transform.Invert(Point2Df(0, viewport.h))
+    };
+
+    float minX = corners[0].X, minY = corners[0].Y, maxX = corners[0].X, maxY = corners[0].Y;
+
+    for (int x = 1; x < 4; x++)
+    {
+        minX = std::min(minX, corners[x].X);
+        minY = std::min(minY, corners[x].Y);
+        maxX = std::max(maxX, corners[x].X);
+        maxY = std::max(maxY, corners[x].Y);
+    }
+
+    return SDL_FRect { minX, minY, maxX - minX, maxY - minY };
+}
+
+CacoEngine::Vector2Df CacoEngine::Camera::WorldToScreen(Vector2Df position, Vector2D output) const
+{
+    SDL_Rect viewport = this->GetViewportRect(output);
+    Point2Df point = this->GetTransform(output).Apply(position);
+
+    return Vector2Df(point.X + viewport.x, point.Y + viewport.y);
+}
+
+CacoEngine::Vector2Df CacoEngine::Camera::ScreenToWorld(Vector2Df position, Vector2D output) const
+{
+    SDL_Rect viewport = this->GetViewportRect(output);
+
+    return this->GetTransform(output).Invert(Point2Df(position.X - viewport.x, position.Y - viewport.y));
+}
@@ -0,0 +1,260 @@
+#include "capture.hpp"
+#include <SDL_render.h>
+#include <SDL_timer.h>
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+CacoEngine::FrameCapture::FrameCapture()
+    : Output(nullptr), Running(false), Stopping(false), FrameSize(Vector2D()), FrameCounter(0), Stats(CaptureStats()),
+      Format(CaptureFormat::Y4M), FrameSkip(0), FrameRate(60)
+{
+}
+
+CacoEngine::FrameCapture::~FrameCapture()
+{
+    this->Stop();
+}
+
+bool CacoEngine::FrameCapture::Start(std::string_view path, CaptureFormat format, int frameSkip, int bufferCount, int frameRate)
+{
+    if (this->Running)
+        this->Stop();
+
+    this->Output = fopen(std::string(path).c_str(), "wb");
+
+    if (!this->Output)
+    {
+        std::cout << "Failed to open capture file " << path << '\n';
+        return false;
+    }
+
+    this->Format = format;
+    this->FrameSkip = std::max(frameSkip, 0);
+    this->FrameRate = std::max(frameRate, 1);
+    this->FrameSize = Vector2D();
+    this->FrameCounter = 0;
+    this->Stats = CaptureStats();
+
+    // Buffers are sized on the first captured frame, once the output size is known
+    this->Buffers = std::vector<std::vector<uint8_t>>(std::max(bufferCount, 1));
+    this->FreeBuffers.clear();
+    this->Pending.clear();
+
+    for (int x = 0; x < this->Buffers.size(); x++)
+        this->FreeBuffers.push_back(x);
+
+    this->Stopping = false;
+    this->Running = true;
+
+    this->Writer = std::thread(&FrameCapture::WriterLoop, this);
+
+    return true;
+}
+
+void CacoEngine::FrameCapture::Stop()
+{
+    if (!this->Running)
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(this->Lock);
+
+        this->Stopping = true;
+    }
+
+    this->Signal.notify_one();
+
+    if (this->Writer.joinable())
+        this->Writer.join();
+
+    fclose(this->Output);
+
+    this->Output = nullptr;
+    this->Running = false;
+}
+
+bool CacoEngine::FrameCapture::IsRunning()
+{
+    return this->Running;
+}
+
+CacoEngine::CaptureStats CacoEngine::FrameCapture::GetStats()
+{
+    std::lock_guard<std::mutex> guard(this->Lock);
+
+    return this->Stats;
+}
+
+void CacoEngine::FrameCapture::CaptureFrame(Renderer& renderer)
+{
+    if (!this->Running)
+        return;
+
+    uint64_t frame = this->FrameCounter++;
+
+    if (this->FrameSkip > 0 && frame % (this->FrameSkip + 1) != 0)
+    {
+        std::lock_guard<std::mutex> guard(this->Lock);
+
+        this->Stats.FramesSkipped++;
+        return;
+    }
+
+    uint64_t start = SDL_GetPerformanceCounter();
+
+    Vector2D size;
+
+    SDL_GetRendererOutputSize(renderer.GetInstance(), &size.X, &size.Y);
+
+    int buffer = -1;
+
+    {
+        std::lock_guard<std::mutex> guard(this->Lock);
+
+        if (this->FrameSize.X == 0 && this->FrameSize.Y == 0)
+        {
+            this->FrameSize = size;
+
+            for (int x = 0; x < this->Buffers.size(); x++)
+                this->Buffers[x].resize(size.X * size.Y * 4);
+        }
+
+        // The stream has a fixed frame size, frames after a resize can't be stored
+        if (size.X != this->FrameSize.X || size.Y != this->FrameSize.Y || this->FreeBuffers.empty())
+        {
+            this->Stats.FramesDropped++;
+            return;
+        }
+
+        buffer = this->FreeBuffers.back();
+        this->FreeBuffers.pop_back();
+    }
+
+    bool success = SDL_RenderReadPixels(renderer.GetInstance(), nullptr, SDL_PIXELFORMAT_RGBA32,
+                                        this->Buffers[buffer].data(), size.X * 4) == 0;
+
+    double elapsed = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+
+    {
+        std::lock_guard<std::mutex> guard(this->Lock);
+
+        if (success)
+        {
+            this->Pending.push_back(PendingFrame { buffer, frame });
+            this->Stats.FramesCaptured++;
+        }
+        else
+        {
+            this->FreeBuffers.push_back(buffer);
+            this->Stats.FramesDropped++;
+        }
+
+        this->Stats.FramesTimed++;
+        this->Stats.LastCaptureTime = elapsed;
+        this->Stats.MaxCaptureTime = std::max(this->Stats.MaxCaptureTime, elapsed);
+        this->Stats.AverageCaptureTime += (elapsed - this->Stats.AverageCaptureTime) / this->Stats.FramesTimed;
+    }
+
+    if (success)
+        this->Signal.notify_one();
+}
+
+size_t CacoEngine::FrameCapture::WriteFrame(const uint8_t* pixels)
+{
+    int width = this->FrameSize.X, height = this->FrameSize.Y;
+
+    if (this->Format == CaptureFormat::RawRGBA)
+        return fwrite(pixels, 1, width * height * 4, this->Output);
+
+    // BT.601 full range ("C420jpeg"), chroma averaged over each 2x2 block
+    int chromaWidth = (width + 1) / 2, chromaHeight = (height + 1) / 2;
+
+    this->Planes.resize(width * height + chromaWidth * chromaHeight * 2);
+
+    uint8_t* yPlane = this->Planes.data();
+    uint8_t* uPlane = yPlane + width * height;
+    uint8_t* vPlane = uPlane + chromaWidth * chromaHeight;
+
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+        {
+            const uint8_t* pixel = pixels + (y * width + x) * 4;
+
+            yPlane[y * width + x] = (uint8_t)std::clamp((77 * pixel[0] + 150 * pixel[1] + 29 * pixel[2] + 128) >> 8, 0, 255);
+        }
+
+    for (int y = 0; y < chromaHeight; y++)
+        for (int x = 0; x < chromaWidth; x++)
+        {
+            int r = 0, g = 0, b = 0, samples = 0;
+
+            for (int dy = 0; dy < 2 && y * 2 + dy < height; dy++)
+                for (int dx = 0; dx < 2 && x * 2 + dx < width; dx++)
+                {
+                    const uint8_t* pixel = pixels + ((y * 2 + dy) * width + (x * 2 + dx)) * 4;
+
+                    r += pixel[0];
+                    g += pixel[1];
+                    b += pixel[2];
+                    samples++;
+                }
+
+            r /= samples;
+            g /= samples;
+            b /= samples;
+
+            uPlane[y * chromaWidth + x] = (uint8_t)std::clamp(((-43 * r - 85 * g + 128 * b + 128) >> 8) + 128, 0, 255);
+            vPlane[y * chromaWidth + x] = (uint8_t)std::clamp(((128 * r - 107 * g - 21 * b + 128) >> 8) + 128, 0, 255);
+        }
+
+    size_t written = fwrite("FRAME\n", 1, 6, this->Output);
+
+    return written + fwrite(this->Planes.data(), 1, this->Planes.size(), this->Output);
+}
+
+void CacoEngine::FrameCapture::WriterLoop()
+{
+    bool headerWritten = false;
+
+    while (true)
+    {
+        PendingFrame frame;
+
+        {
+            std::unique_lock<std::mutex> guard(this->Lock);
+
+            this->Signal.wait(guard, [this]() { return this->Stopping || !this->Pending.empty(); });
+
+            // Drain everything that was captured before stopping
+            if (this->Pending.empty())
+                break;
+
+            frame = this->Pending.front();
+            this->Pending.pop_front();
+        }
+
+        uint64_t start = SDL_GetPerformanceCounter();
+
+        size_t written = 0;
+
+        if (!headerWritten && this->Format == CaptureFormat::Y4M)
+            written += fprintf(this->Output, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", this->FrameSize.X, this->FrameSize.Y, this->FrameRate);
+
+        headerWritten = true;
+
+        written += this->WriteFrame(this->Buffers[frame.Buffer].data());
+
+        double elapsed = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+
+        std::lock_guard<std::mutex> guard(this->Lock);
+
+        this->FreeBuffers.push_back(frame.Buffer);
+
+        this->Stats.FramesWritten++;
+        this->Stats.BytesWritten += written;
+        this->Stats.AverageWriteTime += (elapsed - this->Stats.AverageWriteTime) / this->Stats.FramesWritten;
+    }
+
+    fflush(this->Output);
+}
@@ -0,0 +1,13 @@
+#include "drawable.hpp"
+
+CacoEngine::Drawable::Drawable() : Visible(true)
+{
+}
+
+void CacoEngine::Drawable::Update(double deltaTime)
+{
+}
+
+CacoEngine::Drawable::~Drawable()
+{
+}
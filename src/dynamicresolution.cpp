@@ -0,0 +1,153 @@
+#include "dynamicresolution.hpp"
+#include <SDL_pixels.h>
+#include <SDL_render.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+CacoEngine::DynamicResolution::DynamicResolution()
+    : Target(nullptr), TargetSize(Vector2D()), Scale(1), Active(false), SmoothedFrameTime(0),
+      OverBudgetFrames(0), UnderBudgetFrames(0), Cooldown(0),
+      Enabled(false), TargetFrameTime(1.0 / 60.0), MinScale(0.5f), MaxScale(1), Step(0.05f),
+      OverBudgetRatio(1.05), UnderBudgetRatio(0.8), DownscaleDelay(5), UpscaleDelay(60), CooldownFrames(15)
+{
+}
+
+CacoEngine::DynamicResolution::~DynamicResolution()
+{
+    if (this->Target)
+        SDL_DestroyTexture(this->Target);
+}
+
+void CacoEngine::DynamicResolution::Begin(Renderer& renderer)
+{
+    this->Active = false;
+
+    // At full scale the offscreen pass would only add a copy
+    if (!this->Enabled || this->Scale >= 1)
+        return;
+
+    SDL_Renderer* instance = renderer.GetInstance();
+
+    Vector2D size;
+
+    SDL_GetRendererOutputSize(instance, &size.X, &size.Y);
+
+    if (this->Target && (size.X != this->TargetSize.X || size.Y != this->TargetSize.Y))
+    {
+        SDL_DestroyTexture(this->Target);
+        this->Target = nullptr;
+    }
+
+    // Allocated at full size so scale changes never reallocate, only the top left part is used
+    if (!this->Target)
+    {
+        this->Target = SDL_CreateTexture(instance, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, size.X, size.Y);
+        this->TargetSize = size;
+
+        if (!this->Target)
+        {
+            std::cout << "Failed to create dynamic resolution target: " << SDL_GetError() << '\n';
+
+            this->Enabled = false;
+            return;
+        }
+
+        SDL_SetTextureScaleMode(this->Target, SDL_ScaleModeLinear);
+    }
+
+    SDL_SetRenderTarget(instance, this->Target);
+
+    // Logical coordinates stay those of the window, SDL shrinks everything onto the target
+    SDL_RenderSetScale(instance, this->Scale, this->Scale);
+
+    this->Active = true;
+}
+
+void CacoEngine::DynamicResolution::End(Renderer& renderer)
+{
+    if (!this->Active)
+        return;
+
+    SDL_Renderer* instance = renderer.GetInstance();
+
+    // Batched lines and points still belong to the offscreen target
+    renderer.Flush();
+
+    SDL_SetRenderTarget(instance, nullptr);
+    SDL_RenderSetScale(instance, 1, 1);
+
+    SDL_Rect source = {
+        0, 0,
+        std::max(1, (int)std::lround(this->TargetSize.X * this->Scale)),
+        std::max(1, (int)std::lround(this->TargetSize.Y * this->Scale))
+    };
+
+    renderer.DrawTexture(this->Target, &source, nullptr);
+
+    this->Active = false;
+}
+
+void CacoEngine::DynamicResolution::Update(double frameTime)
+{
+    if (!this->Enabled)
+        return;
+
+    this->SmoothedFrameTime = (this->SmoothedFrameTime <= 0) ? frameTime : this->SmoothedFrameTime * 0.9 + frameTime * 0.1;
+
+    if (this->Cooldown > 0)
+    {
+        this->Cooldown--;
+        return;
+    }
+
+    if (this->SmoothedFrameTime > this->TargetFrameTime * this->OverBudgetRatio)
+    {
+        this->OverBudgetFrames++;
+        this->UnderBudgetFrames = 0;
+    }
+    else if (this->SmoothedFrameTime < this->TargetFrameTime * this->UnderBudgetRatio)
+    {
+        this->UnderBudgetFrames++;
+        this->OverBudgetFrames = 0;
+    }
+    else
+    {
+        this->OverBudgetFrames = 0;
+        this->UnderBudgetFrames = 0;
+    }
+
+    float scale = this->Scale;
+
+    if (this->OverBudgetFrames >= this->DownscaleDelay)
+        scale -= this->Step;
+
+    else if (this->UnderBudgetFrames >= this->UpscaleDelay)
+        scale += this->Step;
+
+    scale = std::clamp(scale, this->MinScale, this->MaxScale);
+
+    if (scale != this->Scale)
+    {
+        this->Scale = scale;
+        this->Cooldown = this->CooldownFrames;
+        this->OverBudgetFrames = 0;
+        this->UnderBudgetFrames = 0;
+    }
+}
+
+float CacoEngine::DynamicResolution::GetScale()
+{
+    return this->Scale;
+}
+
+double CacoEngine::DynamicResolution::GetSmoothedFrameTime()
+{
+    return this->SmoothedFrameTime;
+}
+
+void CacoEngine::DynamicResolution::SetScale(float scale)
+{
+    this->Scale = std::clamp(scale, this->MinScale, this->MaxScale);
+    this->Cooldown = this->CooldownFrames;
+}
@@ -16,6 +16,7 @@
 #include "vertex.hpp"
 #include <memory>
 #include <cmath>
+#include <algorithm>
 
 namespace CacoEngine
 {
@@ -73,6 +74,28 @@ namespace CacoEngine
         return *this->RigidObjects.emplace_back(std::move(object));
     }
 
+    Drawable& Engine::AddDrawable(std::shared_ptr<Drawable> drawable)
+    {
+        return *this->Drawables.emplace_back(std::move(drawable));
+    }
+
+    Camera& Engine::AddCamera(std::shared_ptr<Camera> camera)
+    {
+        return *this->Cameras.emplace_back(std::move(camera));
+    }
+
+    bool Engine::RemoveCamera(const std::shared_ptr<Camera>& camera)
+    {
+        auto it = std::find(this->Cameras.begin(), this->Cameras.end(), camera);
+
+        if (it == this->Cameras.end())
+            return false;
+
+        this->Cameras.erase(it);
+
+        return true;
+    }
+
     void Engine::OnKeyPress(SDL_KeyboardEvent& event)
     {
         this->MapKey(event);
@@ -87,84 +110,89 @@ namespace CacoEngine
     }
 
     void Engine::UpdatePhysics()
-    {   
-        double gravity = 9.8f;
-
-        for (int x = 0; x < this->RigidObjects.size(); x++)
-        {
-            RigidObject2D& object = *this->RigidObjects[x];
-            double dT = this->DeltaTime;
-
-            object.RigidBody.Velocity += (object.RigidBody.Acceleration);
-
-            object.Translate(Vector2Df(object.RigidBody.Velocity.X * dT, object.RigidBody.Velocity.Y * dT));
-
-            if (object.Position.Y > 800)
-                object.Translate(Vector2Df(0, -(object.Position.Y - 800)));
-
-            // object.RigidBody.Force = Vector2Df();
-
-
-            object.RigidBody.UpdateAcceleration();
-
-            object.RigidBody.LastUpdate = this->DeltaTime;
-        }
+    {
+        this->World.Step(this->RigidObjects, this->DeltaTime);
     }
 
     void Engine::Render(SDL_Renderer* renderer, std::vector<std::shared_ptr<Object>>& objects)
     {
+        for (int x = 0; x < objects.size(); x++)
+            this->EngineRenderer.DrawObject(*objects[x]);
+
+        // SDL_RenderPresent(renderer);
+        // SDL_Delay(0);
+    }
 
+    void Engine::Render(SDL_Renderer* renderer, std::vector<std::shared_ptr<RigidObject2D>>& objects)
+    {
         for (int x = 0; x < objects.size(); x++)
-        {
-            Object& object = *objects[x];
+            this->EngineRenderer.DrawObject(*objects[x]);
+    }
 
-            this->EngineRenderer.SetColor(object.FillColor);
+    void Engine::Render(SDL_Renderer* renderer, std::vector<std::shared_ptr<Drawable>>& drawables)
+    {
+        for (int x = 0; x < drawables.size(); x++)
+            if (drawables[x]->Visible)
+                drawables[x]->Draw(this->EngineRenderer);
+    }
 
-            if (object.FillMode == RasterizeMode::WireFrame)
-                SDL_RenderDrawLinesF(renderer = this->EngineRenderer.GetInstance(), object.ObjectMesh.GetPoints().data(), object.ObjectMesh.Vertices.size());
+    void Engine::RenderScene(SDL_Renderer* renderer)
+    {
+        if (this->Cameras.empty())
+        {
+            this->Render(renderer, this->Drawables);
+            this->Render(renderer, this->Objects);
+            this->Render(renderer, this->RigidObjects);
 
-            else if (object.FillMode == RasterizeMode::Points)
-                SDL_RenderDrawPointsF(renderer = this->EngineRenderer.GetInstance(), object.ObjectMesh.GetPoints().data(), object.ObjectMesh.Vertices.size());
+            return;
+        }
 
-            else
-                SDL_RenderGeometry((renderer = this->EngineRenderer.GetInstance()),
-                                    (object.FillMode == RasterizeMode::Texture) ? object.mTexture.mTexture : nullptr,
-                                    object.ObjectMesh.GetVertexBuffer().data(),
-                                    object.ObjectMesh.Vertices.size(),
-                                    nullptr, 0);
+        for (int x = 0; x < this->Cameras.size(); x++)
+        {
+            this->EngineRenderer.SetCamera(this->Cameras[x].get());
 
+            this->Render(renderer, this->Drawables);
+            this->Render(renderer, this->Objects);
+            this->Render(renderer, this->RigidObjects);
         }
 
-        // SDL_RenderPresent(renderer);
-        // SDL_Delay(0);
+        this->EngineRenderer.SetCamera(nullptr);
     }
 
-    void Engine::Render(SDL_Renderer* renderer, std::vector<std::shared_ptr<RigidObject2D>>& objects)
+    void Engine::Present()
     {
-        for (int x = 0; x < objects.size(); x++)
-        {
-            RigidObject2D& object = *objects[x];
+        this->EngineRenderer.Flush();
 
-            // std::shared_ptr<RigidObject2D> ptr = objects[x];
+        this->ResolutionScaling.End(this->EngineRenderer);
 
+        // Must read back before presenting, the back buffer is undefined afterwards
+        this->Capture.CaptureFrame(this->EngineRenderer);
 
-            this->EngineRenderer.SetColor((object).FillColor);
+        SDL_RenderPresent(this->EngineRenderer.GetInstance());
+        SDL_Delay(0);
 
-            if (object.FillMode == RasterizeMode::WireFrame)
-                SDL_RenderDrawLinesF(renderer = this->EngineRenderer.GetInstance(), object.ObjectMesh.GetPoints().data(), object.ObjectMesh.Vertices.size());
+        this->EngineRenderer.EndFrame();
+    }
 
-            else if (object.FillMode == RasterizeMode::Points)
-                SDL_RenderDrawPointsF(renderer = this->EngineRenderer.GetInstance(), object.ObjectMesh.GetPoints().data(), object.ObjectMesh.Vertices.size());
-            else
-                SDL_RenderGeometry((renderer = this->EngineRenderer.GetInstance()),
-                                    (object.FillMode == RasterizeMode::Texture) ? object.mTexture.mTexture : nullptr,
-                                    object.ObjectMesh.GetVertexBuffer().data(),
-                                    object.ObjectMesh.Vertices.size(),
-                                    nullptr, 0);
-        }
+    Renderer& Engine::GetRenderer()
+    {
+        return this->EngineRenderer;
+    }
 
-        SDL_RenderPresent(renderer);
-        SDL_Delay(0);
+    PhysicsWorld& Engine::GetWorld()
+    {
+        return this->World;
+    }
+
+    TextureLoader& Engine::GetTextureLoader()
+    {
+        return this->AsyncTextures;
+    }
+
+    void Engine::UpdateDrawables()
+    {
+        for (int x = 0; x < this->Drawables.size(); x++)
+            this->Drawables[x]->Update(this->DeltaTime);
     }
 
 
@@ -224,14 +252,25 @@ namespace CacoEngine
                 this->KeyStates = const_cast<uint8_t*>(SDL_GetKeyboardState(NULL));
             }
 
+            uint64_t frameStart = SDL_GetPerformanceCounter();
+
+            this->AsyncTextures.Upload(this->EngineRenderer);
+
+            this->ResolutionScaling.Begin(this->EngineRenderer);
+
             this->EngineRenderer.Clear();
             this->EngineRenderer.SetColor(Colors[(int)Color::White]);
 
 
-            this->Render(renderer, this->Objects);
-            this->Render(renderer, this->RigidObjects);
+            this->RenderScene(renderer);
+
+            this->Present();
+
+            // Submission through present, which is where a GPU-bound frame blocks
+            this->ResolutionScaling.Update((SDL_GetPerformanceCounter() - frameStart) / (double)SDL_GetPerformanceFrequency());
 
             this->UpdatePhysics();
+            this->UpdateDrawables();
 
             current = SDL_GetPerformanceCounter();
 
@@ -251,12 +290,19 @@ namespace CacoEngine
             Extension::Audio
         };
 
+        this->World.SetThreadCount(0);
+
         if (initialize)
             this->Initialize();
     }
 
     Engine::~Engine()
     {
+        this->Capture.Stop();
+
+        // Workers may still be inside IMG_Load
+        this->AsyncTextures.Stop();
+
         SDL_DestroyWindow(this->Window);
 
         IMG_Quit();
@@ -0,0 +1,234 @@
+#include "layer.hpp"
+#include <SDL_pixels.h>
+#include <SDL_render.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+CacoEngine::Layer::Layer() : Drawable(), DrawCount(0), Dirty(true), ClearColor(RGBA(0, 0, 0, 0))
+{
+}
+
+CacoEngine::Layer::~Layer()
+{
+    for (auto it = this->Targets.begin(); it != this->Targets.end(); it++)
+        if (it->second.Texture)
+            SDL_DestroyTexture(it->second.Texture);
+}
+
+CacoEngine::Object& CacoEngine::Layer::AddObject(std::shared_ptr<Object> object)
+{
+    this->Dirty = true;
+
+    return *this->Objects.emplace_back(std::move(object));
+}
+
+bool CacoEngine::Layer::RemoveObject(const std::shared_ptr<Object>& object)
+{
+    auto it = std::find(this->Objects.begin(), this->Objects.end(), object);
+
+    if (it == this->Objects.end())
+        return false;
+
+    this->Objects.erase(it);
+    this->Dirty = true;
+
+    return true;
+}
+
+void CacoEngine::Layer::Clear()
+{
+    this->Objects.clear();
+    this->Dirty = true;
+}
+
+void CacoEngine::Layer::Invalidate()
+{
+    this->Dirty = true;
+}
+
+bool CacoEngine::Layer::IsDirty()
+{
+    return this->Dirty;
+}
+
+std::vector<std::shared_ptr<CacoEngine::Object>>& CacoEngine::Layer::GetObjects()
+{
+    return this->Objects;
+}
+
+CacoEngine::Layer::Target& CacoEngine::Layer::GetTarget(float zoom)
+{
+    auto found = this->Targets.find(zoom);
+
+    if (found != this->Targets.end())
+        return found->second;
+
+    Target target = Target { nullptr, Vector2D(), SDL_FRect { 0, 0, 0, 0 }, true, 0 };
+
+    if (this->Targets.size() >= MaxTargets)
+    {
+        auto oldest = this->Targets.begin();
+
+        for (auto it = this->Targets.begin(); it != this->Targets.end(); it++)
+            if (it->second.LastUsed < oldest->second.LastUsed)
+                oldest = it;
+
+        // A smoothly changing zoom cycles through here, the texture is reused when its size still fits
+        target.Texture = oldest->second.Texture;
+        target.Size = oldest->second.Size;
+
+        this->Targets.erase(oldest);
+    }
+
+    return this->Targets.emplace(zoom, target).first->second;
+}
+
+void CacoEngine::Layer::Rebuild(Renderer& renderer, Target& target, float zoom)
+{
+    SDL_Renderer* instance = renderer.GetInstance();
+
+    target.Stale = false;
+
+    float minX = std::numeric_limits<float>::max(), minY = minX;
+    float maxX = std::numeric_limits<float>::lowest(), maxY = maxX;
+
+    for (int x = 0; x < this->Objects.size(); x++)
+        for (const Vertex2Df& vertex : this->Objects[x]->ObjectMesh.Vertices)
+        {
+            minX = std::min(minX, vertex.Position.X);
+            minY = std::min(minY, vertex.Position.Y);
+            maxX = std::max(maxX, vertex.Position.X);
+            maxY = std::max(maxY, vertex.Position.Y);
+        }
+
+    if (minX > maxX)
+    {
+        target.Bounds = SDL_FRect { 0, 0, 0, 0 };
+        return;
+    }
+
+    // Room for hairlines and points drawn on the edge
+    minX -= 1;
+    minY -= 1;
+    maxX += 1;
+    maxY += 1;
+
+    SDL_RendererInfo info;
+
+    if (SDL_GetRendererInfo(instance, &info) != 0 || info.max_texture_width <= 0 || info.max_texture_height <= 0)
+        info.max_texture_width = info.max_texture_height = 4096;
+
+    float scale = std::min({ zoom, info.max_texture_width / (maxX - minX), info.max_texture_height / (maxY - minY) });
+
+    Vector2D size((int)std::ceil((maxX - minX) * scale), (int)std::ceil((maxY - minY) * scale));
+
+    // Texels land on whole world positions divided by the scale, the covered area is rounded up with them
+    target.Bounds = SDL_FRect { minX, minY, size.X / scale, size.Y / scale };
+
+    if (target.Texture && (size.X != target.Size.X || size.Y != target.Size.Y))
+    {
+        SDL_DestroyTexture(target.Texture);
+        target.Texture = nullptr;
+    }
+
+    if (!target.Texture)
+    {
+        target.Texture = SDL_CreateTexture(instance, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, size.X, size.Y);
+        target.Size = size;
+
+        if (!target.Texture)
+            return;
+
+        SDL_SetTextureBlendMode(target.Texture, SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_Texture* previous = SDL_GetRenderTarget(instance);
+    RGBA previousColor = renderer.Color;
+
+    CameraTransform previousTransform = renderer.GetTransform();
+    SDL_FRect previousArea = renderer.GetVisibleArea();
+
+    // Switching targets resets the viewport and scale, the camera's and the
+    // dynamic resolution's have to come back afterwards
+    SDL_Rect viewport;
+    float scaleX, scaleY;
+
+    SDL_RenderGetViewport(instance, &viewport);
+    SDL_RenderGetScale(instance, &scaleX, &scaleY);
+
+    // Anything queued so far belongs to the previous target
+    renderer.Flush();
+
+    SDL_SetRenderTarget(instance, target.Texture);
+    SDL_RenderSetScale(instance, 1, 1);
+
+    // World to texels, the bounds' corner at the texture's origin
+    CameraTransform transform;
+
+    transform.A = transform.D = scale;
+    transform.TX = -minX * scale;
+    transform.TY = -minY * scale;
+
+    renderer.SetTransform(transform, target.Bounds);
+    renderer.Clear(this->ClearColor);
+
+    for (int x = 0; x < this->Objects.size(); x++)
+        renderer.DrawObject(*this->Objects[x]);
+
+    // Batched wireframes and points belong to this target, not the frame
+    renderer.Flush();
+
+    SDL_SetRenderTarget(instance, previous);
+    SDL_RenderSetScale(instance, scaleX, scaleY);
+    SDL_RenderSetViewport(instance, &viewport);
+    renderer.SetTransform(previousTransform, previousArea);
+    renderer.SetColor(previousColor);
+}
+
+void CacoEngine::Layer::Draw(Renderer& renderer)
+{
+    const CameraTransform& transform = renderer.GetTransform();
+
+    // Screen pixels per world unit, rotation aside
+    float zoom = std::sqrt(std::abs(transform.A * transform.D - transform.B * transform.C));
+
+    if (zoom <= 0)
+        return;
+
+    // Every zoom's texture shows the old members, each is rebuilt when next drawn
+    if (this->Dirty)
+    {
+        for (auto it = this->Targets.begin(); it != this->Targets.end(); it++)
+            it->second.Stale = true;
+
+        this->Dirty = false;
+    }
+
+    Target& target = this->GetTarget(zoom);
+
+    target.LastUsed = ++this->DrawCount;
+
+    if (target.Stale)
+        this->Rebuild(renderer, target, zoom);
+
+    if (!target.Texture || target.Bounds.w <= 0)
+        return;
+
+    float left = target.Bounds.x, top = target.Bounds.y;
+    float right = left + target.Bounds.w, bottom = top + target.Bounds.h;
+
+    RGBA white(255, 255, 255, 255);
+
+    // One quad in world space, the renderer moves it with the camera
+    Vertex2Df quad[6] = {
+        Vertex2Df(Vector2Df(left, top), white, Vector2Df(0, 0)),
+        Vertex2Df(Vector2Df(right, top), white, Vector2Df(1, 0)),
+        Vertex2Df(Vector2Df(right, bottom), white, Vector2Df(1, 1)),
+        Vertex2Df(Vector2Df(left, top), white, Vector2Df(0, 0)),
+        Vertex2Df(Vector2Df(right, bottom), white, Vector2Df(1, 1)),
+        Vertex2Df(Vector2Df(left, bottom), white, Vector2Df(0, 1))
+    };
+
+    renderer.DrawGeometry(target.Texture, quad, 6);
+}
@@ -26,7 +26,8 @@
 namespace GameConstants {
     // Physics constants
     constexpr float DEFAULT_CIRCLE_RADIUS = 50.0f;
-    constexpr float MOVEMENT_FORCE = 100.0f;
+    // Applied once per key press, forces only last one physics step
+    constexpr float MOVEMENT_IMPULSE = 100.0f;
     constexpr float JUMP_FORCE = 700.0f;
     constexpr float BOUNDARY_FORCE = 200.0f;
     constexpr float WORLD_BOUNDARY = 1000.0f;
@@ -71,7 +72,7 @@ public:
     
     void execute() override {
         if (!rigidObjects.empty()) {
-            rigidObjects.back()->RigidBody.AddForce(direction);
+            rigidObjects.back()->RigidBody.AddImpulse(direction);
         }
     }
 };
@@ -97,8 +98,9 @@ private:
     std::unordered_map<std::string, CacoEngine::Texture> textureCache;
     
 public:
-    void loadTexture(const std::string& name, const std::string& filename, CacoEngine::Renderer& renderer) {
-        textureCache[name] = CacoEngine::TextureManager::CreateTexture(filename, renderer);
+    // Returns at once; the texture draws a placeholder until the engine uploads it
+    void loadTexture(const std::string& name, const std::string& filename, CacoEngine::TextureLoader& loader, CacoEngine::Renderer& renderer) {
+        textureCache[name] = loader.Load(filename, renderer);
     }
     
     const CacoEngine::Texture& getTexture(const std::string& name) const {
@@ -184,13 +186,16 @@ private:
     std::unique_ptr<TextureManager> textureManager;
     std::unique_ptr<GameObjectManager> objectManager;
     
+    // Persistent so the broadphase state carries over between frames
+    std::unique_ptr<CacoEngine::RigidCircleCollider> collider;
+    
     // Input command mapping
     std::unordered_map<SDL_Keycode, std::unique_ptr<InputCommand>> keyCommands;
     
     void initializeTextures() {
-        textureManager->loadTexture(std::string(TextureNames::CACODEMON), "cacodemon.png", EngineRenderer);
-        textureManager->loadTexture(std::string(TextureNames::CACODEMON_LEFT), "cacodemon_left.png", EngineRenderer);
-        textureManager->loadTexture(std::string(TextureNames::CACODEMON_RIGHT), "cacodemon_right.png", EngineRenderer);
+        textureManager->loadTexture(std::string(TextureNames::CACODEMON), "cacodemon.png", GetTextureLoader(), EngineRenderer);
+        textureManager->loadTexture(std::string(TextureNames::CACODEMON_LEFT), "cacodemon_left.png", GetTextureLoader(), EngineRenderer);
+        textureManager->loadTexture(std::string(TextureNames::CACODEMON_RIGHT), "cacodemon_right.png", GetTextureLoader(), EngineRenderer);
     }
     
     void initializeObjects() {
@@ -217,22 +222,22 @@ private:
     void initializeInputCommands() {
         keyCommands[SDLK_LEFT] = std::make_unique<MoveCommand>(
             objectManager->getRigidObjects(),
-            CacoEngine::Vector2Df(-GameConstants::MOVEMENT_FORCE, 0)
+            CacoEngine::Vector2Df(-GameConstants::MOVEMENT_IMPULSE, 0)
         );
         
         keyCommands[SDLK_RIGHT] = std::make_unique<MoveCommand>(
             objectManager->getRigidObjects(),
-            CacoEngine::Vector2Df(GameConstants::MOVEMENT_FORCE, 0)
+            CacoEngine::Vector2Df(GameConstants::MOVEMENT_IMPULSE, 0)
         );
         
         keyCommands[SDLK_UP] = std::make_unique<MoveCommand>(
             objectManager->getRigidObjects(),
-            CacoEngine::Vector2Df(0, -GameConstants::MOVEMENT_FORCE)
+            CacoEngine::Vector2Df(0, -GameConstants::MOVEMENT_IMPULSE)
         );
         
         keyCommands[SDLK_DOWN] = std::make_unique<MoveCommand>(
             objectManager->getRigidObjects(),
-            CacoEngine::Vector2Df(0, GameConstants::MOVEMENT_FORCE)
+            CacoEngine::Vector2Df(0, GameConstants::MOVEMENT_IMPULSE)
         );
         
         keyCommands[SDLK_SPACE] = std::make_unique<JumpCommand>(
@@ -255,12 +260,7 @@ private:
     void handleCollisions() {
         if (objectManager->getRigidObjects().empty()) return;
         
-        CacoEngine::RigidCircleCollider collider(
-            objectManager->getRigidCircles(),
-            objectManager->getRigidObjects()
-        );
-        
-        collider.Handle();
+        collider->Handle();
     }
     
 public:
@@ -276,6 +276,11 @@ public:
         initializeObjects();
         initializeInputCommands();
         
+        collider = std::make_unique<CacoEngine::RigidCircleCollider>(
+            objectManager->getRigidCircles(),
+            objectManager->getRigidObjects()
+        );
+        
                  // Set up engine object references
          for (auto& obj : objectManager->getObjects()) {
              this->AddObject(obj);
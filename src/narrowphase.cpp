@@ -0,0 +1,1112 @@
+#include "narrowphase.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Below this distance two centers are treated as coincident
+static constexpr float Epsilon = 1e-6f;
+
+// Vertices this close to the deepest one share the contact point, so flat resting faces
+// report the middle of the touching edge
+static constexpr float FeatureTolerance = 1e-2f;
+
+#if defined(__SSE2__)
+static inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+static inline float Dot(CacoEngine::Point2Df a, CacoEngine::Point2Df b)
+{
+    return a.X * b.X + a.Y * b.Y;
+}
+
+static inline float Cross(CacoEngine::Point2Df o, CacoEngine::Point2Df a, CacoEngine::Point2Df b)
+{
+    return (a.X - o.X) * (b.Y - o.Y) - (a.Y - o.Y) * (b.X - o.X);
+}
+
+CacoEngine::Contact::Contact(int a, int b, Point2Df normal, float depth, Point2Df point) : A(a), B(b), Normal(normal), Depth(depth), Point(point) {}
+
+CacoEngine::Narrowphase::Narrowphase() {}
+
+CacoEngine::Narrowphase::~Narrowphase() {}
+
+int CacoEngine::Narrowphase::AddCircle(Point2Df center, float radius)
+{
+    this->Shapes.push_back({ ShapeType::Circle, (int)this->CircleX.size() });
+
+    this->CircleX.push_back(center.X);
+    this->CircleY.push_back(center.Y);
+    this->CircleRadius.push_back(radius);
+
+    return this->Shapes.size() - 1;
+}
+
+int CacoEngine::Narrowphase::AddBox(const AABB& box)
+{
+    this->Shapes.push_back({ ShapeType::Box, (int)this->BoxMinX.size() });
+
+    this->BoxMinX.push_back(box.MinX);
+    this->BoxMinY.push_back(box.MinY);
+    this->BoxMaxX.push_back(box.MaxX);
+    this->BoxMaxY.push_back(box.MaxY);
+
+    return this->Shapes.size() - 1;
+}
+
+int CacoEngine::Narrowphase::AddOrientedBox(Point2Df center, Point2Df extents, float rotation)
+{
+    this->Shapes.push_back({ ShapeType::OrientedBox, (int)this->OrientedBoxes.size() });
+
+    this->OrientedBoxes.push_back({ center, extents, Point2Df(std::cos(rotation), std::sin(rotation)) });
+
+    return this->Shapes.size() - 1;
+}
+
+int CacoEngine::Narrowphase::AddPolygon(const Point2Df* points, int count, int stride)
+{
+    std::vector<Point2Df>& sorted = this->SortedPoints;
+    std::vector<Point2Df>& hull = this->HullPoints;
+
+    sorted.clear();
+
+    for (int x = 0; x < count; x++)
+        sorted.push_back(*(const Point2Df*)((const uint8_t*)points + x * stride));
+
+    // Monotone chain, the hull comes out counter-clockwise in a y-up frame
+    std::sort(sorted.begin(), sorted.end(), [](const Point2Df& a, const Point2Df& b)
+    {
+        return (a.X != b.X) ? a.X < b.X : a.Y < b.Y;
+    });
+
+    hull.resize(2 * sorted.size());
+
+    int size = 0;
+
+    for (int x = 0; x < sorted.size(); x++)
+    {
+        while (size >= 2 && Cross(hull[size - 2], hull[size - 1], sorted[x]) <= Epsilon)
+            size--;
+
+        hull[size++] = sorted[x];
+    }
+
+    for (int x = (int)sorted.size() - 2, lower = size + 1; x >= 0; x--)
+    {
+        while (size >= lower && Cross(hull[size - 2], hull[size - 1], sorted[x]) <= Epsilon)
+            size--;
+
+        hull[size++] = sorted[x];
+    }
+
+    // The last point repeats the first
+    size--;
+
+    if (size < 3)
+    {
+        AABB bounds = count ? AABB(sorted[0].X, sorted[0].Y, sorted[0].X, sorted[0].Y) : AABB();
+
+        for (int x = 1; x < count; x++)
+            bounds = bounds.Merge(AABB(sorted[x].X, sorted[x].Y, sorted[x].X, sorted[x].Y));
+
+        return this->AddBox(bounds);
+    }
+
+    this->Shapes.push_back({ ShapeType::Polygon, (int)this->Polygons.size() });
+    this->Polygons.push_back({ (int)this->PolygonVertices.size(), size });
+
+    for (int x = 0; x < size; x++)
+    {
+        Point2Df edge(hull[(x + 1) % size].X - hull[x].X, hull[(x + 1) % size].Y - hull[x].Y);
+
+        float length = std::sqrt(Dot(edge, edge));
+
+        this->PolygonVertices.push_back(hull[x]);
+        this->PolygonNormals.push_back(Point2Df(edge.Y / length, -edge.X / length));
+    }
+
+    return this->Shapes.size() - 1;
+}
+
+void CacoEngine::Narrowphase::Clear()
+{
+    this->Shapes.clear();
+
+    this->CircleX.clear();
+    this->CircleY.clear();
+    this->CircleRadius.clear();
+
+    this->BoxMinX.clear();
+    this->BoxMinY.clear();
+    this->BoxMaxX.clear();
+    this->BoxMaxY.clear();
+
+    this->OrientedBoxes.clear();
+
+    this->Polygons.clear();
+    this->PolygonVertices.clear();
+    this->PolygonNormals.clear();
+}
+
+int CacoEngine::Narrowphase::GetShapeCount()
+{
+    return this->Shapes.size();
+}
+
+CacoEngine::ShapeType CacoEngine::Narrowphase::GetShapeType(int shape)
+{
+    return this->Shapes[shape].Type;
+}
+
+CacoEngine::Narrowphase::PolygonView CacoEngine::Narrowphase::GetPolygon(int shape, Point2Df* vertices, Point2Df* normals)
+{
+    const ShapeRef& ref = this->Shapes[shape];
+
+    if (ref.Type == ShapeType::Polygon)
+    {
+        const Polygon& polygon = this->Polygons[ref.Index];
+
+        return { &this->PolygonVertices[polygon.First], &this->PolygonNormals[polygon.First], polygon.Count };
+    }
+
+    OrientedBox box;
+
+    if (ref.Type == ShapeType::Box)
+    {
+        box.Center = Point2Df((this->BoxMinX[ref.Index] + this->BoxMaxX[ref.Index]) * 0.5f, (this->BoxMinY[ref.Index] + this->BoxMaxY[ref.Index]) * 0.5f);
+        box.Extents = Point2Df((this->BoxMaxX[ref.Index] - this->BoxMinX[ref.Index]) * 0.5f, (this->BoxMaxY[ref.Index] - this->BoxMinY[ref.Index]) * 0.5f);
+        box.Axis = Point2Df(1, 0);
+    }
+    else
+        box = this->OrientedBoxes[ref.Index];
+
+    Point2Df u(box.Axis.X * box.Extents.X, box.Axis.Y * box.Extents.X);
+    Point2Df v(-box.Axis.Y * box.Extents.Y, box.Axis.X * box.Extents.Y);
+
+    vertices[0] = Point2Df(box.Center.X - u.X - v.X, box.Center.Y - u.Y - v.Y);
+    vertices[1] = Point2Df(box.Center.X + u.X - v.X, box.Center.Y + u.Y - v.Y);
+    vertices[2] = Point2Df(box.Center.X + u.X + v.X, box.Center.Y + u.Y + v.Y);
+    vertices[3] = Point2Df(box.Center.X - u.X + v.X, box.Center.Y - u.Y + v.Y);
+
+    normals[0] = Point2Df(box.Axis.Y, -box.Axis.X);
+    normals[1] = Point2Df(box.Axis.X, box.Axis.Y);
+    normals[2] = Point2Df(-box.Axis.Y, box.Axis.X);
+    normals[3] = Point2Df(-box.Axis.X, -box.Axis.Y);
+
+    return { vertices, normals, 4 };
+}
+
+bool CacoEngine::Narrowphase::TestCircles(Point2Df a, float radiusA, Point2Df b, float radiusB, Contact* contact)
+{
+    float dx = b.X - a.X, dy = b.Y - a.Y;
+    float length = std::sqrt(dx * dx + dy * dy);
+    float depth = (radiusA + radiusB) - length;
+
+    if (!(depth > 0))
+        return false;
+
+    if (contact)
+    {
+        float inverse = 1.0f / length;
+
+        contact->Normal = (length > Epsilon) ? Point2Df(dx * inverse, dy * inverse) : Point2Df(1, 0);
+        contact->Depth = depth;
+
+        float offset = radiusA - depth * 0.5f;
+
+        contact->Point = Point2Df(a.X + contact->Normal.X * offset, a.Y + contact->Normal.Y * offset);
+    }
+
+    return true;
+}
+
+bool CacoEngine::Narrowphase::TestCircleBox(Point2Df center, float radius, const AABB& box, Contact* contact)
+{
+    float closestX = std::min(std::max(center.X, box.MinX), box.MaxX);
+    float closestY = std::min(std::max(center.Y, box.MinY), box.MaxY);
+
+    float dx = closestX - center.X, dy = closestY - center.Y;
+    float length = std::sqrt(dx * dx + dy * dy);
+
+    if (length > Epsilon)
+    {
+        float depth = radius - length;
+
+        if (!(depth > 0))
+            return false;
+
+        if (contact)
+        {
+            float inverse = 1.0f / length;
+
+            contact->Normal = Point2Df(dx * inverse, dy * inverse);
+            contact->Depth = depth;
+            contact->Point = Point2Df(closestX + contact->Normal.X * depth * 0.5f, closestY + contact->Normal.Y * depth * 0.5f);
+        }
+
+        return true;
+    }
+
+    // Center inside the box, push out through the nearest face
+    if (contact)
+    {
+        float left = center.X - box.MinX, right = box.MaxX - center.X;
+        float top = center.Y - box.MinY, bottom = box.MaxY - center.Y;
+
+        float nearestX = std::min(left, right), nearestY = std::min(top, bottom);
+
+        if (nearestX <= nearestY)
+        {
+            contact->Normal = Point2Df((left < right) ? 1 : -1, 0);
+            contact->Depth = radius + nearestX;
+        }
+        else
+        {
+            contact->Normal = Point2Df(0, (top < bottom) ? 1 : -1);
+            contact->Depth = radius + nearestY;
+        }
+
+        contact->Point = center;
+    }
+
+    return true;
+}
+
+bool CacoEngine::Narrowphase::TestBoxes(const AABB& a, const AABB& b, Contact* contact)
+{
+    // Distance B has to travel to clear A on each axis, in whichever direction is shorter
+    float overlapX = std::min(a.MaxX - b.MinX, b.MaxX - a.MinX);
+    float overlapY = std::min(a.MaxY - b.MinY, b.MaxY - a.MinY);
+
+    float depth = std::min(overlapX, overlapY);
+
+    if (!(depth > 0))
+        return false;
+
+    if (contact)
+    {
+        // Separate along the axis of least overlap, towards B's side
+        if (overlapX < overlapY)
+            contact->Normal = Point2Df((b.MinX + b.MaxX >= a.MinX + a.MaxX) ? 1 : -1, 0);
+        else
+            contact->Normal = Point2Df(0, (b.MinY + b.MaxY >= a.MinY + a.MaxY) ? 1 : -1);
+
+        contact->Depth = depth;
+        contact->Point = Point2Df((std::max(a.MinX, b.MinX) + std::min(a.MaxX, b.MaxX)) * 0.5f,
+                                  (std::max(a.MinY, b.MinY) + std::min(a.MaxY, b.MaxY)) * 0.5f);
+    }
+
+    return true;
+}
+
+bool CacoEngine::Narrowphase::TestCircles(FixedVector2 a, Fixed radiusA, FixedVector2 b, Fixed radiusB, Contact* contact)
+{
+    FixedVector2 delta = b - a;
+    Fixed length = delta.Length();
+    Fixed depth = (radiusA + radiusB) - length;
+
+    if (depth <= Fixed())
+        return false;
+
+    if (contact)
+    {
+        FixedVector2 normal = (length > Fixed()) ? FixedVector2(delta.X / length, delta.Y / length) : FixedVector2(Fixed(1), Fixed());
+        FixedVector2 point = a + normal * (radiusA - Fixed::FromRaw(depth.Raw >> 1));
+
+        contact->Normal = Point2Df(normal.X.ToFloat(), normal.Y.ToFloat());
+        contact->Depth = depth.ToFloat();
+        contact->Point = Point2Df(point.X.ToFloat(), point.Y.ToFloat());
+    }
+
+    return true;
+}
+
+bool CacoEngine::Narrowphase::TestCircleBox(FixedVector2 center, Fixed radius, const FixedAABB& box, Contact* contact)
+{
+    FixedVector2 closest(Fixed::Min(Fixed::Max(center.X, box.MinX), box.MaxX), Fixed::Min(Fixed::Max(center.Y, box.MinY), box.MaxY));
+
+    FixedVector2 delta = closest - center;
+    Fixed length = delta.Length();
+
+    if (length > Fixed())
+    {
+        Fixed depth = radius - length;
+
+        if (depth <= Fixed())
+            return false;
+
+        if (contact)
+        {
+            FixedVector2 normal(delta.X / length, delta.Y / length);
+            FixedVector2 point = closest + normal * Fixed::FromRaw(depth.Raw >> 1);
+
+            contact->Normal = Point2Df(normal.X.ToFloat(), normal.Y.ToFloat());
+            contact->Depth = depth.ToFloat();
+            contact->Point = Point2Df(point.X.ToFloat(), point.Y.ToFloat());
+        }
+
+        return true;
+    }
+
+    // Center inside the box, push out through the nearest face
+    if (contact)
+    {
+        Fixed left = center.X - box.MinX, right = box.MaxX - center.X;
+        Fixed top = center.Y - box.MinY, bottom = box.MaxY - center.Y;
+
+        Fixed nearestX = Fixed::Min(left, right), nearestY = Fixed::Min(top, bottom);
+
+        if (nearestX <= nearestY)
+        {
+            contact->Normal = Point2Df((left < right) ? 1 : -1, 0);
+            contact->Depth = (radius + nearestX).ToFloat();
+        }
+        else
+        {
+            contact->Normal = Point2Df(0, (top < bottom) ? 1 : -1);
+            contact->Depth = (radius + nearestY).ToFloat();
+        }
+
+        contact->Point = Point2Df(center.X.ToFloat(), center.Y.ToFloat());
+    }
+
+    return true;
+}
+
+bool CacoEngine::Narrowphase::TestBoxes(const FixedAABB& a, const FixedAABB& b, Contact* contact)
+{
+    Fixed overlapX = Fixed::Min(a.MaxX - b.MinX, b.MaxX - a.MinX);
+    Fixed overlapY = Fixed::Min(a.MaxY - b.MinY, b.MaxY - a.MinY);
+
+    Fixed depth = Fixed::Min(overlapX, overlapY);
+
+    if (depth <= Fixed())
+        return false;
+
+    if (contact)
+    {
+        if (overlapX < overlapY)
+            contact->Normal = Point2Df((b.MinX + b.MaxX >= a.MinX + a.MaxX) ? 1 : -1, 0);
+        else
+            contact->Normal = Point2Df(0, (b.MinY + b.MaxY >= a.MinY + a.MaxY) ? 1 : -1);
+
+        Fixed pointX = Fixed::Max(a.MinX, b.MinX) + Fixed::Min(a.MaxX, b.MaxX);
+        Fixed pointY = Fixed::Max(a.MinY, b.MinY) + Fixed::Min(a.MaxY, b.MaxY);
+
+        contact->Depth = depth.ToFloat();
+        contact->Point = Point2Df(Fixed::FromRaw(pointX.Raw >> 1).ToFloat(), Fixed::FromRaw(pointY.Raw >> 1).ToFloat());
+    }
+
+    return true;
+}
+
+bool CacoEngine::Narrowphase::SweepCircles(Point2Df start, Point2Df end, float radius, Point2Df center, float otherRadius, float* fraction, Point2Df* normal)
+{
+    // |start + t * d - center| = radius + otherRadius, earliest root
+    float dx = end.X - start.X, dy = end.Y - start.Y;
+    float fx = start.X - center.X, fy = start.Y - center.Y;
+    float reach = radius + otherRadius;
+
+    float a = dx * dx + dy * dy, b = 2 * (fx * dx + fy * dy), c = fx * fx + fy * fy - reach * reach;
+
+    if (c <= 0 || a <= Epsilon)
+        return false;
+
+    float discriminant = b * b - 4 * a * c;
+
+    if (discriminant < 0)
+        return false;
+
+    float t = (-b - std::sqrt(discriminant)) / (2 * a);
+
+    if (t < 0 || t > 1)
+        return false;
+
+    if (fraction)
+        *fraction = t;
+
+    if (normal)
+    {
+        float x = center.X - (start.X + dx * t), y = center.Y - (start.Y + dy * t);
+
+        *normal = Point2Df(x / reach, y / reach);
+    }
+
+    return true;
+}
+
+bool CacoEngine::Narrowphase::SweepCircleBox(Point2Df start, Point2Df end, float radius, const AABB& box, float* fraction, Point2Df* normal)
+{
+    if (TestCircleBox(start, radius, box))
+        return false;
+
+    // The center runs into the box grown by the radius, with rounded corners
+    float t;
+
+    if (!box.Expand(radius).IntersectsSegment(start, end, &t))
+        return false;
+
+    float x = start.X + (end.X - start.X) * t, y = start.Y + (end.Y - start.Y) * t;
+
+    bool besideX = x < box.MinX || x > box.MaxX, besideY = y < box.MinY || y > box.MaxY;
+
+    // Entering a corner square, the path can only touch that corner's disc
+    if (besideX && besideY)
+    {
+        Point2Df corner(std::min(std::max(x, box.MinX), box.MaxX), std::min(std::max(y, box.MinY), box.MaxY));
+
+        return SweepCircles(start, end, radius, corner, 0, fraction, normal);
+    }
+
+    if (fraction)
+        *fraction = t;
+
+    if (normal)
+        *normal = besideX ? Point2Df((x < box.MinX) ? 1 : -1, 0) : Point2Df(0, (y < box.MinY) ? 1 : -1);
+
+    return true;
+}
+
+bool CacoEngine::Narrowphase::SweepBoxes(const AABB& box, Point2Df offset, const AABB& other, float* fraction, Point2Df* normal)
+{
+    if (TestBoxes(box, other))
+        return false;
+
+    // The center of the moving box against the other grown by its half extents
+    Point2Df center = box.GetCenter(), extents = box.GetExtents();
+
+    AABB grown(other.MinX - extents.X, other.MinY - extents.Y, other.MaxX + extents.X, other.MaxY + extents.Y);
+
+    if (!grown.IntersectsSegment(center, Point2Df(center.X + offset.X, center.Y + offset.Y), fraction))
+        return false;
+
+    if (normal)
+    {
+        // The face hit is on the axis whose slab the center entered last
+        float enterX = (offset.X > 0) ? (grown.MinX - center.X) / offset.X : (offset.X < 0) ? (grown.MaxX - center.X) / offset.X : -1;
+        float enterY = (offset.Y > 0) ? (grown.MinY - center.Y) / offset.Y : (offset.Y < 0) ? (grown.MaxY - center.Y) / offset.Y : -1;
+
+        *normal = (enterX >= enterY) ? Point2Df((offset.X > 0) ? 1 : -1, 0) : Point2Df(0, (offset.Y > 0) ? 1 : -1);
+    }
+
+    return true;
+}
+
+void CacoEngine::Narrowphase::ResizeLanes(Workspace& workspace, int count)
+{
+    for (int x = 0; x < 4; x++)
+    {
+        workspace.LaneA[x].resize(count);
+        workspace.LaneB[x].resize(count);
+    }
+
+    workspace.LaneDepth.resize(count);
+    workspace.LaneNormalX.resize(count);
+    workspace.LaneNormalY.resize(count);
+    workspace.LanePointX.resize(count);
+    workspace.LanePointY.resize(count);
+}
+
+void CacoEngine::Narrowphase::GatherCircles(const std::vector<BatchPair>& pairs, std::vector<float>* lanes, bool second)
+{
+    for (int x = 0; x < pairs.size(); x++)
+    {
+        int index = this->Shapes[second ? pairs[x].B : pairs[x].A].Index;
+
+        lanes[0][x] = this->CircleX[index];
+        lanes[1][x] = this->CircleY[index];
+        lanes[2][x] = this->CircleRadius[index];
+    }
+}
+
+void CacoEngine::Narrowphase::GatherBoxes(const std::vector<BatchPair>& pairs, std::vector<float>* lanes, bool second)
+{
+    for (int x = 0; x < pairs.size(); x++)
+    {
+        int index = this->Shapes[second ? pairs[x].B : pairs[x].A].Index;
+
+        lanes[0][x] = this->BoxMinX[index];
+        lanes[1][x] = this->BoxMinY[index];
+        lanes[2][x] = this->BoxMaxX[index];
+        lanes[3][x] = this->BoxMaxY[index];
+    }
+}
+
+void CacoEngine::Narrowphase::EmitLanes(const std::vector<BatchPair>& pairs, std::vector<Contact>& contacts, Workspace& workspace)
+{
+    for (int x = 0; x < pairs.size(); x++)
+    {
+        if (!(workspace.LaneDepth[x] > 0))
+            continue;
+
+        Point2Df normal(workspace.LaneNormalX[x], workspace.LaneNormalY[x]);
+        Point2Df point(workspace.LanePointX[x], workspace.LanePointY[x]);
+
+        if (pairs[x].Swapped)
+            contacts.emplace_back(pairs[x].B, pairs[x].A, Point2Df(-normal.X, -normal.Y), workspace.LaneDepth[x], point);
+        else
+            contacts.emplace_back(pairs[x].A, pairs[x].B, normal, workspace.LaneDepth[x], point);
+    }
+}
+
+void CacoEngine::Narrowphase::CollideCircles(const std::vector<BatchPair>& pairs, std::vector<Contact>& contacts, Workspace& workspace)
+{
+    int count = pairs.size();
+
+    this->ResizeLanes(workspace, count);
+    this->GatherCircles(pairs, workspace.LaneA, false);
+    this->GatherCircles(pairs, workspace.LaneB, true);
+
+    const float* ax = workspace.LaneA[0].data(), *ay = workspace.LaneA[1].data(), *ar = workspace.LaneA[2].data();
+    const float* bx = workspace.LaneB[0].data(), *by = workspace.LaneB[1].data(), *br = workspace.LaneB[2].data();
+
+    int x = 0;
+
+#if defined(__AVX2__)
+    const __m256 one8 = _mm256_set1_ps(1.0f), half8 = _mm256_set1_ps(0.5f), epsilon8 = _mm256_set1_ps(Epsilon);
+
+    for (; x + 8 <= count; x += 8)
+    {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(bx + x), _mm256_loadu_ps(ax + x));
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(by + x), _mm256_loadu_ps(ay + x));
+
+        __m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+        __m256 radiusA = _mm256_loadu_ps(ar + x);
+        __m256 depth = _mm256_sub_ps(_mm256_add_ps(radiusA, _mm256_loadu_ps(br + x)), length);
+
+        __m256 inverse = _mm256_div_ps(one8, length);
+        __m256 apart = _mm256_cmp_ps(length, epsilon8, _CMP_GT_OQ);
+
+        __m256 nx = _mm256_blendv_ps(one8, _mm256_mul_ps(dx, inverse), apart);
+        __m256 ny = _mm256_and_ps(apart, _mm256_mul_ps(dy, inverse));
+
+        __m256 offset = _mm256_sub_ps(radiusA, _mm256_mul_ps(depth, half8));
+
+        _mm256_storeu_ps(&workspace.LaneDepth[x], depth);
+        _mm256_storeu_ps(&workspace.LaneNormalX[x], nx);
+        _mm256_storeu_ps(&workspace.LaneNormalY[x], ny);
+        _mm256_storeu_ps(&workspace.LanePointX[x], _mm256_add_ps(_mm256_loadu_ps(ax + x), _mm256_mul_ps(nx, offset)));
+        _mm256_storeu_ps(&workspace.LanePointY[x], _mm256_add_ps(_mm256_loadu_ps(ay + x), _mm256_mul_ps(ny, offset)));
+    }
+#endif
+
+#if defined(__SSE2__)
+    const __m128 one = _mm_set1_ps(1.0f), half = _mm_set1_ps(0.5f), epsilon = _mm_set1_ps(Epsilon);
+
+    for (; x + 4 <= count; x += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(bx + x), _mm_loadu_ps(ax + x));
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(by + x), _mm_loadu_ps(ay + x));
+
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        __m128 radiusA = _mm_loadu_ps(ar + x);
+        __m128 depth = _mm_sub_ps(_mm_add_ps(radiusA, _mm_loadu_ps(br + x)), length);
+
+        __m128 inverse = _mm_div_ps(one, length);
+        __m128 apart = _mm_cmpgt_ps(length, epsilon);
+
+        __m128 nx = Select(apart, _mm_mul_ps(dx, inverse), one);
+        __m128 ny = _mm_and_ps(apart, _mm_mul_ps(dy, inverse));
+
+        __m128 offset = _mm_sub_ps(radiusA, _mm_mul_ps(depth, half));
+
+        _mm_storeu_ps(&workspace.LaneDepth[x], depth);
+        _mm_storeu_ps(&workspace.LaneNormalX[x], nx);
+        _mm_storeu_ps(&workspace.LaneNormalY[x], ny);
+        _mm_storeu_ps(&workspace.LanePointX[x], _mm_add_ps(_mm_loadu_ps(ax + x), _mm_mul_ps(nx, offset)));
+        _mm_storeu_ps(&workspace.LanePointY[x], _mm_add_ps(_mm_loadu_ps(ay + x), _mm_mul_ps(ny, offset)));
+    }
+#endif
+
+    for (; x < count; x++)
+    {
+        Contact contact;
+
+        workspace.LaneDepth[x] = 0;
+
+        if (!TestCircles(Point2Df(ax[x], ay[x]), ar[x], Point2Df(bx[x], by[x]), br[x], &contact))
+            continue;
+
+        workspace.LaneDepth[x] = contact.Depth;
+        workspace.LaneNormalX[x] = contact.Normal.X;
+        workspace.LaneNormalY[x] = contact.Normal.Y;
+        workspace.LanePointX[x] = contact.Point.X;
+        workspace.LanePointY[x] = contact.Point.Y;
+    }
+
+    this->EmitLanes(pairs, contacts, workspace);
+}
+
+void CacoEngine::Narrowphase::CollideCircleBoxes(const std::vector<BatchPair>& pairs, std::vector<Contact>& contacts, Workspace& workspace)
+{
+    int count = pairs.size();
+
+    this->ResizeLanes(workspace, count);
+    this->GatherCircles(pairs, workspace.LaneA, false);
+    this->GatherBoxes(pairs, workspace.LaneB, true);
+
+    const float* cx = workspace.LaneA[0].data(), *cy = workspace.LaneA[1].data(), *cr = workspace.LaneA[2].data();
+    const float* minX = workspace.LaneB[0].data(), *minY = workspace.LaneB[1].data(), *maxX = workspace.LaneB[2].data(), *maxY = workspace.LaneB[3].data();
+
+    int x = 0;
+
+#if defined(__AVX2__)
+    const __m256 one8 = _mm256_set1_ps(1.0f), half8 = _mm256_set1_ps(0.5f), epsilon8 = _mm256_set1_ps(Epsilon);
+    const __m256 sign8 = _mm256_set1_ps(-0.0f);
+
+    for (; x + 8 <= count; x += 8)
+    {
+        __m256 centerX = _mm256_loadu_ps(cx + x), centerY = _mm256_loadu_ps(cy + x), radius = _mm256_loadu_ps(cr + x);
+        __m256 boxMinX = _mm256_loadu_ps(minX + x), boxMinY = _mm256_loadu_ps(minY + x);
+        __m256 boxMaxX = _mm256_loadu_ps(maxX + x), boxMaxY = _mm256_loadu_ps(maxY + x);
+
+        __m256 closestX = _mm256_min_ps(_mm256_max_ps(centerX, boxMinX), boxMaxX);
+        __m256 closestY = _mm256_min_ps(_mm256_max_ps(centerY, boxMinY), boxMaxY);
+
+        __m256 dx = _mm256_sub_ps(closestX, centerX), dy = _mm256_sub_ps(closestY, centerY);
+        __m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+        __m256 outside = _mm256_cmp_ps(length, epsilon8, _CMP_GT_OQ);
+
+        // Outside: towards the closest point
+        __m256 inverse = _mm256_div_ps(one8, length);
+        __m256 outsideNX = _mm256_mul_ps(dx, inverse), outsideNY = _mm256_mul_ps(dy, inverse);
+        __m256 outsideDepth = _mm256_sub_ps(radius, length);
+        __m256 shift = _mm256_mul_ps(outsideDepth, half8);
+
+        // Inside: through the nearest face
+        __m256 left = _mm256_sub_ps(centerX, boxMinX), right = _mm256_sub_ps(boxMaxX, centerX);
+        __m256 top = _mm256_sub_ps(centerY, boxMinY), bottom = _mm256_sub_ps(boxMaxY, centerY);
+        __m256 nearestX = _mm256_min_ps(left, right), nearestY = _mm256_min_ps(top, bottom);
+        __m256 useX = _mm256_cmp_ps(nearestX, nearestY, _CMP_LE_OQ);
+
+        __m256 signX = _mm256_andnot_ps(_mm256_cmp_ps(left, right, _CMP_LT_OQ), sign8);
+        __m256 signY = _mm256_andnot_ps(_mm256_cmp_ps(top, bottom, _CMP_LT_OQ), sign8);
+
+        __m256 insideNX = _mm256_and_ps(useX, _mm256_or_ps(one8, signX));
+        __m256 insideNY = _mm256_andnot_ps(useX, _mm256_or_ps(one8, signY));
+        __m256 insideDepth = _mm256_add_ps(radius, _mm256_blendv_ps(nearestY, nearestX, useX));
+
+        __m256 nx = _mm256_blendv_ps(insideNX, outsideNX, outside);
+        __m256 ny = _mm256_blendv_ps(insideNY, outsideNY, outside);
+
+        _mm256_storeu_ps(&workspace.LaneDepth[x], _mm256_blendv_ps(insideDepth, outsideDepth, outside));
+        _mm256_storeu_ps(&workspace.LaneNormalX[x], nx);
+        _mm256_storeu_ps(&workspace.LaneNormalY[x], ny);
+        _mm256_storeu_ps(&workspace.LanePointX[x], _mm256_blendv_ps(centerX, _mm256_add_ps(closestX, _mm256_mul_ps(nx, shift)), outside));
+        _mm256_storeu_ps(&workspace.LanePointY[x], _mm256_blendv_ps(centerY, _mm256_add_ps(closestY, _mm256_mul_ps(ny, shift)), outside));
+    }
+#endif
+
+#if defined(__SSE2__)
+    const __m128 one = _mm_set1_ps(1.0f), half = _mm_set1_ps(0.5f), epsilon = _mm_set1_ps(Epsilon);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+
+    for (; x + 4 <= count; x += 4)
+    {
+        __m128 centerX = _mm_loadu_ps(cx + x), centerY = _mm_loadu_ps(cy + x), radius = _mm_loadu_ps(cr + x);
+        __m128 boxMinX = _mm_loadu_ps(minX + x), boxMinY = _mm_loadu_ps(minY + x);
+        __m128 boxMaxX = _mm_loadu_ps(maxX + x), boxMaxY = _mm_loadu_ps(maxY + x);
+
+        __m128 closestX = _mm_min_ps(_mm_max_ps(centerX, boxMinX), boxMaxX);
+        __m128 closestY = _mm_min_ps(_mm_max_ps(centerY, boxMinY), boxMaxY);
+
+        __m128 dx = _mm_sub_ps(closestX, centerX), dy = _mm_sub_ps(closestY, centerY);
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        __m128 outside = _mm_cmpgt_ps(length, epsilon);
+
+        __m128 inverse = _mm_div_ps(one, length);
+        __m128 outsideNX = _mm_mul_ps(dx, inverse), outsideNY = _mm_mul_ps(dy, inverse);
+        __m128 outsideDepth = _mm_sub_ps(radius, length);
+        __m128 shift = _mm_mul_ps(outsideDepth, half);
+
+        __m128 left = _mm_sub_ps(centerX, boxMinX), right = _mm_sub_ps(boxMaxX, centerX);
+        __m128 top = _mm_sub_ps(centerY, boxMinY), bottom = _mm_sub_ps(boxMaxY, centerY);
+        __m128 nearestX = _mm_min_ps(left, right), nearestY = _mm_min_ps(top, bottom);
+        __m128 useX = _mm_cmple_ps(nearestX, nearestY);
+
+        __m128 signX = _mm_andnot_ps(_mm_cmplt_ps(left, right), sign);
+        __m128 signY = _mm_andnot_ps(_mm_cmplt_ps(top, bottom), sign);
+
+        __m128 insideNX = _mm_and_ps(useX, _mm_or_ps(one, signX));
+        __m128 insideNY = _mm_andnot_ps(useX, _mm_or_ps(one, signY));
+        __m128 insideDepth = _mm_add_ps(radius, Select(useX, nearestX, nearestY));
+
+        __m128 nx = Select(outside, outsideNX, insideNX);
+        __m128 ny = Select(outside, outsideNY, insideNY);
+
+        _mm_storeu_ps(&workspace.LaneDepth[x], Select(outside, outsideDepth, insideDepth));
+        _mm_storeu_ps(&workspace.LaneNormalX[x], nx);
+        _mm_storeu_ps(&workspace.LaneNormalY[x], ny);
+        _mm_storeu_ps(&workspace.LanePointX[x], Select(outside, _mm_add_ps(closestX, _mm_mul_ps(nx, shift)), centerX));
+        _mm_storeu_ps(&workspace.LanePointY[x], Select(outside, _mm_add_ps(closestY, _mm_mul_ps(ny, shift)), centerY));
+    }
+#endif
+
+    for (; x < count; x++)
+    {
+        Contact contact;
+
+        workspace.LaneDepth[x] = 0;
+
+        if (!TestCircleBox(Point2Df(cx[x], cy[x]), cr[x], AABB(minX[x], minY[x], maxX[x], maxY[x]), &contact))
+            continue;
+
+        workspace.LaneDepth[x] = contact.Depth;
+        workspace.LaneNormalX[x] = contact.Normal.X;
+        workspace.LaneNormalY[x] = contact.Normal.Y;
+        workspace.LanePointX[x] = contact.Point.X;
+        workspace.LanePointY[x] = contact.Point.Y;
+    }
+
+    this->EmitLanes(pairs, contacts, workspace);
+}
+
+void CacoEngine::Narrowphase::CollideBoxes(const std::vector<BatchPair>& pairs, std::vector<Contact>& contacts, Workspace& workspace)
+{
+    int count = pairs.size();
+
+    this->ResizeLanes(workspace, count);
+    this->GatherBoxes(pairs, workspace.LaneA, false);
+    this->GatherBoxes(pairs, workspace.LaneB, true);
+
+    const float* aMinX = workspace.LaneA[0].data(), *aMinY = workspace.LaneA[1].data(), *aMaxX = workspace.LaneA[2].data(), *aMaxY = workspace.LaneA[3].data();
+    const float* bMinX = workspace.LaneB[0].data(), *bMinY = workspace.LaneB[1].data(), *bMaxX = workspace.LaneB[2].data(), *bMaxY = workspace.LaneB[3].data();
+
+    int x = 0;
+
+#if defined(__AVX2__)
+    const __m256 one8 = _mm256_set1_ps(1.0f), half8 = _mm256_set1_ps(0.5f), sign8 = _mm256_set1_ps(-0.0f);
+
+    for (; x + 8 <= count; x += 8)
+    {
+        __m256 minAX = _mm256_loadu_ps(aMinX + x), minAY = _mm256_loadu_ps(aMinY + x);
+        __m256 maxAX = _mm256_loadu_ps(aMaxX + x), maxAY = _mm256_loadu_ps(aMaxY + x);
+        __m256 minBX = _mm256_loadu_ps(bMinX + x), minBY = _mm256_loadu_ps(bMinY + x);
+        __m256 maxBX = _mm256_loadu_ps(bMaxX + x), maxBY = _mm256_loadu_ps(bMaxY + x);
+
+        __m256 lowX = _mm256_max_ps(minAX, minBX), highX = _mm256_min_ps(maxAX, maxBX);
+        __m256 lowY = _mm256_max_ps(minAY, minBY), highY = _mm256_min_ps(maxAY, maxBY);
+
+        __m256 overlapX = _mm256_min_ps(_mm256_sub_ps(maxAX, minBX), _mm256_sub_ps(maxBX, minAX));
+        __m256 overlapY = _mm256_min_ps(_mm256_sub_ps(maxAY, minBY), _mm256_sub_ps(maxBY, minAY));
+        __m256 useX = _mm256_cmp_ps(overlapX, overlapY, _CMP_LT_OQ);
+
+        // Negative when B's center lies before A's
+        __m256 signX = _mm256_andnot_ps(_mm256_cmp_ps(_mm256_add_ps(minBX, maxBX), _mm256_add_ps(minAX, maxAX), _CMP_GE_OQ), sign8);
+        __m256 signY = _mm256_andnot_ps(_mm256_cmp_ps(_mm256_add_ps(minBY, maxBY), _mm256_add_ps(minAY, maxAY), _CMP_GE_OQ), sign8);
+
+        _mm256_storeu_ps(&workspace.LaneDepth[x], _mm256_min_ps(overlapX, overlapY));
+        _mm256_storeu_ps(&workspace.LaneNormalX[x], _mm256_and_ps(useX, _mm256_or_ps(one8, signX)));
+        _mm256_storeu_ps(&workspace.LaneNormalY[x], _mm256_andnot_ps(useX, _mm256_or_ps(one8, signY)));
+        _mm256_storeu_ps(&workspace.LanePointX[x], _mm256_mul_ps(_mm256_add_ps(lowX, highX), half8));
+        _mm256_storeu_ps(&workspace.LanePointY[x], _mm256_mul_ps(_mm256_add_ps(lowY, highY), half8));
+    }
+#endif
+
+#if defined(__SSE2__)
+    const __m128 one = _mm_set1_ps(1.0f), half = _mm_set1_ps(0.5f), sign = _mm_set1_ps(-0.0f);
+
+    for (; x + 4 <= count; x += 4)
+    {
+        __m128 minAX = _mm_loadu_ps(aMinX + x), minAY = _mm_loadu_ps(aMinY + x);
+        __m128 maxAX = _mm_loadu_ps(aMaxX + x), maxAY = _mm_loadu_ps(aMaxY + x);
+        __m128 minBX = _mm_loadu_ps(bMinX + x), minBY = _mm_loadu_ps(bMinY + x);
+        __m128 maxBX = _mm_loadu_ps(bMaxX + x), maxBY = _mm_loadu_ps(bMaxY + x);
+
+        __m128 lowX = _mm_max_ps(minAX, minBX), highX = _mm_min_ps(maxAX, maxBX);
+        __m128 lowY = _mm_max_ps(minAY, minBY), highY = _mm_min_ps(maxAY, maxBY);
+
+        __m128 overlapX = _mm_min_ps(_mm_sub_ps(maxAX, minBX), _mm_sub_ps(maxBX, minAX));
+        __m128 overlapY = _mm_min_ps(_mm_sub_ps(maxAY, minBY), _mm_sub_ps(maxBY, minAY));
+        __m128 useX = _mm_cmplt_ps(overlapX, overlapY);
+
+        __m128 signX = _mm_andnot_ps(_mm_cmpge_ps(_mm_add_ps(minBX, maxBX), _mm_add_ps(minAX, maxAX)), sign);
+        __m128 signY = _mm_andnot_ps(_mm_cmpge_ps(_mm_add_ps(minBY, maxBY), _mm_add_ps(minAY, maxAY)), sign);
+
+        _mm_storeu_ps(&workspace.LaneDepth[x], _mm_min_ps(overlapX, overlapY));
+        _mm_storeu_ps(&workspace.LaneNormalX[x], _mm_and_ps(useX, _mm_or_ps(one, signX)));
+        _mm_storeu_ps(&workspace.LaneNormalY[x], _mm_andnot_ps(useX, _mm_or_ps(one, signY)));
+        _mm_storeu_ps(&workspace.LanePointX[x], _mm_mul_ps(_mm_add_ps(lowX, highX), half));
+        _mm_storeu_ps(&workspace.LanePointY[x], _mm_mul_ps(_mm_add_ps(lowY, highY), half));
+    }
+#endif
+
+    for (; x < count; x++)
+    {
+        Contact contact;
+
+        workspace.LaneDepth[x] = 0;
+
+        if (!TestBoxes(AABB(aMinX[x], aMinY[x], aMaxX[x], aMaxY[x]), AABB(bMinX[x], bMinY[x], bMaxX[x], bMaxY[x]), &contact))
+            continue;
+
+        workspace.LaneDepth[x] = contact.Depth;
+        workspace.LaneNormalX[x] = contact.Normal.X;
+        workspace.LaneNormalY[x] = contact.Normal.Y;
+        workspace.LanePointX[x] = contact.Point.X;
+        workspace.LanePointY[x] = contact.Point.Y;
+    }
+
+    this->EmitLanes(pairs, contacts, workspace);
+}
+
+// Largest signed distance of the second polygon's vertices from one of the first's faces
+static float FindMaxSeparation(const CacoEngine::Point2Df* verticesA, const CacoEngine::Point2Df* normalsA, int countA,
+                               const CacoEngine::Point2Df* verticesB, int countB, int& face)
+{
+    float best = -INFINITY;
+
+    for (int x = 0; x < countA; x++)
+    {
+        float separation = INFINITY;
+
+        for (int y = 0; y < countB; y++)
+            separation = std::min(separation, normalsA[x].X * (verticesB[y].X - verticesA[x].X) + normalsA[x].Y * (verticesB[y].Y - verticesA[x].Y));
+
+        if (separation > best)
+        {
+            best = separation;
+            face = x;
+        }
+    }
+
+    return best;
+}
+
+bool CacoEngine::Narrowphase::CollidePair(const BatchPair& pair, Contact& contact)
+{
+    const ShapeRef& a = this->Shapes[pair.A];
+    const ShapeRef& b = this->Shapes[pair.B];
+
+    contact.A = pair.A;
+    contact.B = pair.B;
+
+    if (a.Type == ShapeType::Circle && b.Type == ShapeType::Circle)
+        return TestCircles(Point2Df(this->CircleX[a.Index], this->CircleY[a.Index]), this->CircleRadius[a.Index],
+                           Point2Df(this->CircleX[b.Index], this->CircleY[b.Index]), this->CircleRadius[b.Index], &contact);
+
+    if (a.Type == ShapeType::Circle && b.Type == ShapeType::Box)
+        return TestCircleBox(Point2Df(this->CircleX[a.Index], this->CircleY[a.Index]), this->CircleRadius[a.Index],
+                             AABB(this->BoxMinX[b.Index], this->BoxMinY[b.Index], this->BoxMaxX[b.Index], this->BoxMaxY[b.Index]), &contact);
+
+    if (a.Type == ShapeType::Box && b.Type == ShapeType::Box)
+        return TestBoxes(AABB(this->BoxMinX[a.Index], this->BoxMinY[a.Index], this->BoxMaxX[a.Index], this->BoxMaxY[a.Index]),
+                         AABB(this->BoxMinX[b.Index], this->BoxMinY[b.Index], this->BoxMaxX[b.Index], this->BoxMaxY[b.Index]), &contact);
+
+    Point2Df verticesB[4], normalsB[4];
+    PolygonView polygonB = this->GetPolygon(pair.B, verticesB, normalsB);
+
+    if (a.Type == ShapeType::Circle)
+    {
+        Point2Df center(this->CircleX[a.Index], this->CircleY[a.Index]);
+        float radius = this->CircleRadius[a.Index];
+
+        // Face of the polygon closest to the center
+        float best = -INFINITY;
+        int face = 0;
+
+        for (int x = 0; x < polygonB.Count; x++)
+        {
+            Point2Df offset(center.X - polygonB.Vertices[x].X, center.Y - polygonB.Vertices[x].Y);
+            float separation = Dot(polygonB.Normals[x], offset);
+
+            if (separation > radius)
+                return false;
+
+            if (separation > best)
+            {
+                best = separation;
+                face = x;
+            }
+        }
+
+        Point2Df normal = polygonB.Normals[face];
+
+        if (best < Epsilon)
+        {
+            contact.Normal = Point2Df(-normal.X, -normal.Y);
+            contact.Depth = radius - best;
+            contact.Point = Point2Df(center.X - normal.X * best, center.Y - normal.Y * best);
+
+            return true;
+        }
+
+        // Closest point on that face, which also covers its corner regions
+        Point2Df start = polygonB.Vertices[face], end = polygonB.Vertices[(face + 1) % polygonB.Count];
+        Point2Df edge(end.X - start.X, end.Y - start.Y);
+
+        float t = std::clamp(Dot(edge, Point2Df(center.X - start.X, center.Y - start.Y)) / Dot(edge, edge), 0.0f, 1.0f);
+
+        Point2Df closest(start.X + edge.X * t, start.Y + edge.Y * t);
+        Point2Df offset(closest.X - center.X, closest.Y - center.Y);
+
+        float length = std::sqrt(Dot(offset, offset));
+        float depth = radius - length;
+
+        if (!(depth > 0))
+            return false;
+
+        contact.Normal = Point2Df(offset.X / length, offset.Y / length);
+        contact.Depth = depth;
+        contact.Point = Point2Df(closest.X + contact.Normal.X * depth * 0.5f, closest.Y + contact.Normal.Y * depth * 0.5f);
+
+        return true;
+    }
+
+    Point2Df verticesA[4], normalsA[4];
+    PolygonView polygonA = this->GetPolygon(pair.A, verticesA, normalsA);
+
+    int faceA = 0, faceB = 0;
+
+    float separationA = FindMaxSeparation(polygonA.Vertices, polygonA.Normals, polygonA.Count, polygonB.Vertices, polygonB.Count, faceA);
+
+    if (separationA > 0)
+        return false;
+
+    float separationB = FindMaxSeparation(polygonB.Vertices, polygonB.Normals, polygonB.Count, polygonA.Vertices, polygonA.Count, faceB);
+
+    if (separationB > 0)
+        return false;
+
+    // The face with the least penetration is the reference, the other polygon's deepest
+    // vertices against it give the contact point
+    const PolygonView& incident = (separationB > separationA) ? polygonA : polygonB;
+
+    Point2Df reference = (separationB > separationA) ? polygonB.Normals[faceB] : polygonA.Normals[faceA];
+    float depth = -std::max(separationA, separationB);
+
+    contact.Normal = (separationB > separationA) ? Point2Df(-reference.X, -reference.Y) : reference;
+    contact.Depth = depth;
+
+    float deepest = INFINITY;
+
+    for (int x = 0; x < incident.Count; x++)
+        deepest = std::min(deepest, Dot(reference, incident.Vertices[x]));
+
+    Point2Df point;
+    int count = 0;
+
+    for (int x = 0; x < incident.Count; x++)
+    {
+        if (Dot(reference, incident.Vertices[x]) > deepest + FeatureTolerance)
+            continue;
+
+        point.X += incident.Vertices[x].X;
+        point.Y += incident.Vertices[x].Y;
+        count++;
+    }
+
+    contact.Point = Point2Df(point.X / count + reference.X * depth * 0.5f, point.Y / count + reference.Y * depth * 0.5f);
+
+    return true;
+}
+
+void CacoEngine::Narrowphase::CollideGeneric(const std::vector<BatchPair>& pairs, std::vector<Contact>& contacts)
+{
+    Contact contact;
+
+    for (int x = 0; x < pairs.size(); x++)
+    {
+        if (!this->CollidePair(pairs[x], contact))
+            continue;
+
+        if (pairs[x].Swapped)
+            contacts.emplace_back(contact.B, contact.A, Point2Df(-contact.Normal.X, -contact.Normal.Y), contact.Depth, contact.Point);
+        else
+            contacts.push_back(contact);
+    }
+}
+
+void CacoEngine::Narrowphase::CollideRange(const BroadphasePair* pairs, int count, std::vector<Contact>& contacts, Workspace& workspace)
+{
+    const int types = (int)ShapeType::Count;
+
+    for (int x = 0; x < types * types; x++)
+        workspace.Buckets[x].clear();
+
+    for (int x = 0; x < count; x++)
+    {
+        int typeA = (int)this->Shapes[pairs[x].A].Type, typeB = (int)this->Shapes[pairs[x].B].Type;
+
+        if (typeA <= typeB)
+            workspace.Buckets[typeA * types + typeB].push_back({ pairs[x].A, pairs[x].B, false });
+        else
+            workspace.Buckets[typeB * types + typeA].push_back({ pairs[x].B, pairs[x].A, true });
+    }
+
+    for (int x = 0; x < types * types; x++)
+    {
+        std::vector<BatchPair>& bucket = workspace.Buckets[x];
+
+        if (bucket.empty())
+            continue;
+
+        if (x == (int)ShapeType::Circle * types + (int)ShapeType::Circle)
+            this->CollideCircles(bucket, contacts, workspace);
+        else if (x == (int)ShapeType::Circle * types + (int)ShapeType::Box)
+            this->CollideCircleBoxes(bucket, contacts, workspace);
+        else if (x == (int)ShapeType::Box * types + (int)ShapeType::Box)
+            this->CollideBoxes(bucket, contacts, workspace);
+        else
+            this->CollideGeneric(bucket, contacts);
+    }
+}
+
+void CacoEngine::Narrowphase::Collide(const std::vector<BroadphasePair>& pairs, std::vector<Contact>& contacts)
+{
+    contacts.clear();
+
+    if (this->Workspaces.empty())
+        this->Workspaces.resize(1);
+
+    this->CollideRange(pairs.data(), pairs.size(), contacts, this->Workspaces[0]);
+}
+
+void CacoEngine::Narrowphase::Collide(const std::vector<BroadphasePair>& pairs, std::vector<Contact>& contacts, ThreadPool& pool)
+{
+    const int pairsPerChunk = 2048;
+
+    contacts.clear();
+
+    if (this->Workspaces.size() < pool.GetThreadCount())
+        this->Workspaces.resize(pool.GetThreadCount());
+
+    this->ChunkContacts.resize((pairs.size() + pairsPerChunk - 1) / pairsPerChunk);
+
+    pool.ParallelFor(pairs.size(), pairsPerChunk, [&](int begin, int end, int thread)
+    {
+        std::vector<Contact>& chunk = this->ChunkContacts[begin / pairsPerChunk];
+
+        chunk.clear();
+
+        this->CollideRange(&pairs[begin], end - begin, chunk, this->Workspaces[thread]);
+    });
+
+    for (int x = 0; x < this->ChunkContacts.size(); x++)
+        contacts.insert(contacts.end(), this->ChunkContacts[x].begin(), this->ChunkContacts[x].end());
+}
+
+bool CacoEngine::Narrowphase::Test(int a, int b, Contact* contact)
+{
+    bool swapped = this->Shapes[a].Type > this->Shapes[b].Type;
+
+    Contact result;
+
+    if (!this->CollidePair(swapped ? BatchPair{ b, a, true } : BatchPair{ a, b, false }, result))
+        return false;
+
+    if (contact)
+    {
+        *contact = result;
+
+        if (swapped)
+            *contact = Contact(a, b, Point2Df(-result.Normal.X, -result.Normal.Y), result.Depth, result.Point);
+    }
+
+    return true;
+}
@@ -138,6 +138,21 @@ void CacoEngine::Mesh::AddTriangle(Vertex2Df vertex, Vertex2Df vertex1, Vertex2D
     this->Vertices.push_back(vertex2);
 }
 
+void CacoEngine::Mesh::SetQuadRegion(TextureRegion region, bool flipX, bool flipY)
+{
+    // Unit UV corners in the order Rectangle emits its vertices
+    static const float corners[6][2] = { { 0, 0 }, { 0, 1 }, { 1, 1 }, { 1, 1 }, { 1, 0 }, { 0, 0 } };
+
+    if (this->Vertices.size() != 6)
+        return;
+
+    float u0 = (flipX) ? region.U1 : region.U0, u1 = (flipX) ? region.U0 : region.U1;
+    float v0 = (flipY) ? region.V1 : region.V0, v1 = (flipY) ? region.V0 : region.V1;
+
+    for (int x = 0; x < 6; x++)
+        this->Vertices[x].TextureCoordinates = Point2Df((corners[x][0] != 0) ? u1 : u0, (corners[x][1] != 0) ? v1 : v0);
+}
+
 CacoEngine::Rectangle::Rectangle(Vector2Df dimensions, Vector2Df position, RGBA color, Texture texture) : Object()
 {
     this->Position = position;
@@ -0,0 +1,284 @@
+#include "particles.hpp"
+#include <algorithm>
+#include <cmath>
+#include <SDL_render.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+CacoEngine::ParticleEmitter::ParticleEmitter(EmitterShape shape, Vector2Df position)
+    : Shape(shape), Position(position), Extents(Vector2Df()), Direction(0), Spread(0), MinSpeed(50), MaxSpeed(100),
+      MinLifetime(1), MaxLifetime(2), Rate(0), Accumulator(0), Enabled(true)
+{
+}
+
+CacoEngine::ParticleSystem::ParticleSystem(int capacity)
+    : Drawable(), Count(0), Capacity(std::max(capacity, 0)), Generator(std::random_device()()), Gravity(Vector2Df()), Drag(0), ParticleSize(2)
+{
+    this->PositionX.resize(this->Capacity);
+    this->PositionY.resize(this->Capacity);
+    this->VelocityX.resize(this->Capacity);
+    this->VelocityY.resize(this->Capacity);
+    this->Life.resize(this->Capacity);
+    this->InverseLifetime.resize(this->Capacity);
+    this->BaseColors.resize(this->Capacity);
+}
+
+CacoEngine::ParticleSystem::~ParticleSystem()
+{
+}
+
+int CacoEngine::ParticleSystem::AddEmitter(ParticleEmitter emitter)
+{
+    this->Emitters.push_back(emitter);
+
+    return this->Emitters.size() - 1;
+}
+
+CacoEngine::ParticleEmitter& CacoEngine::ParticleSystem::GetEmitter(int emitter)
+{
+    return this->Emitters[emitter];
+}
+
+float CacoEngine::ParticleSystem::RandomRange(float min, float max)
+{
+    return (max > min) ? std::uniform_real_distribution<float>(min, max)(this->Generator) : min;
+}
+
+bool CacoEngine::ParticleSystem::Emit(Vector2Df position, Vector2Df velocity, float lifetime, RGBA color)
+{
+    if (this->Count >= this->Capacity || lifetime <= 0)
+        return false;
+
+    int index = this->Count++;
+
+    this->PositionX[index] = position.X;
+    this->PositionY[index] = position.Y;
+    this->VelocityX[index] = velocity.X;
+    this->VelocityY[index] = velocity.Y;
+    this->Life[index] = lifetime;
+    this->InverseLifetime[index] = 1.0f / lifetime;
+    this->BaseColors[index] = color;
+
+    return true;
+}
+
+void CacoEngine::ParticleSystem::Spawn(ParticleEmitter& emitter)
+{
+    const float tau = 6.28318530718f;
+
+    float angle = this->RandomRange(0, tau);
+    float speed = this->RandomRange(emitter.MinSpeed, emitter.MaxSpeed);
+
+    Vector2Df position = emitter.Position;
+
+    switch (emitter.Shape)
+    {
+        case EmitterShape::Point:
+            break;
+
+        case EmitterShape::Circle:
+        {
+            // sqrt keeps the distribution uniform over the disk's area
+            float radius = emitter.Extents.X * std::sqrt(this->RandomRange(0, 1));
+            float placement = this->RandomRange(0, tau);
+
+            position += Vector2Df(std::cos(placement) * radius, std::sin(placement) * radius);
+            break;
+        }
+
+        case EmitterShape::Ring:
+            position += Vector2Df(std::cos(angle) * emitter.Extents.X, std::sin(angle) * emitter.Extents.X);
+            break;
+
+        case EmitterShape::Rectangle:
+            position += Vector2Df(this->RandomRange(-emitter.Extents.X, emitter.Extents.X), this->RandomRange(-emitter.Extents.Y, emitter.Extents.Y));
+            break;
+
+        case EmitterShape::Cone:
+            angle = emitter.Direction + this->RandomRange(-emitter.Spread * 0.5f, emitter.Spread * 0.5f);
+            break;
+    }
+
+    RGBA color = (emitter.Palette.empty()) ? Colors[(int)Color::White]
+                                           : emitter.Palette[std::uniform_int_distribution<int>(0, emitter.Palette.size() - 1)(this->Generator)];
+
+    this->Emit(position, Vector2Df(std::cos(angle) * speed, std::sin(angle) * speed),
+               this->RandomRange(emitter.MinLifetime, emitter.MaxLifetime), color);
+}
+
+void CacoEngine::ParticleSystem::Emit(int emitter, int count)
+{
+    count = std::min(count, this->Capacity - this->Count);
+
+    for (int x = 0; x < count; x++)
+        this->Spawn(this->Emitters[emitter]);
+}
+
+void CacoEngine::ParticleSystem::Clear()
+{
+    this->Count = 0;
+}
+
+int CacoEngine::ParticleSystem::GetCount()
+{
+    return this->Count;
+}
+
+int CacoEngine::ParticleSystem::GetCapacity()
+{
+    return this->Capacity;
+}
+
+void CacoEngine::ParticleSystem::Integrate(float deltaTime)
+{
+    // Semi-implicit Euler with linear drag: v = v * damping + g * dt, p += v * dt
+    float damping = std::max(0.0f, 1.0f - this->Drag * deltaTime);
+    float gravityX = this->Gravity.X * deltaTime, gravityY = this->Gravity.Y * deltaTime;
+
+    float* px = this->PositionX.data();
+    float* py = this->PositionY.data();
+    float* vx = this->VelocityX.data();
+    float* vy = this->VelocityY.data();
+    float* life = this->Life.data();
+
+    int x = 0;
+
+#if defined(__AVX2__)
+    __m256 dt8 = _mm256_set1_ps(deltaTime), damping8 = _mm256_set1_ps(damping);
+    __m256 gx8 = _mm256_set1_ps(gravityX), gy8 = _mm256_set1_ps(gravityY);
+
+    for (; x + 8 <= this->Count; x += 8)
+    {
+        __m256 velocityX = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(vx + x), damping8), gx8);
+        __m256 velocityY = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(vy + x), damping8), gy8);
+
+        _mm256_storeu_ps(vx + x, velocityX);
+        _mm256_storeu_ps(vy + x, velocityY);
+        _mm256_storeu_ps(px + x, _mm256_add_ps(_mm256_loadu_ps(px + x), _mm256_mul_ps(velocityX, dt8)));
+        _mm256_storeu_ps(py + x, _mm256_add_ps(_mm256_loadu_ps(py + x), _mm256_mul_ps(velocityY, dt8)));
+        _mm256_storeu_ps(life + x, _mm256_sub_ps(_mm256_loadu_ps(life + x), dt8));
+    }
+#elif defined(__SSE2__)
+    __m128 dt4 = _mm_set1_ps(deltaTime), damping4 = _mm_set1_ps(damping);
+    __m128 gx4 = _mm_set1_ps(gravityX), gy4 = _mm_set1_ps(gravityY);
+
+    for (; x + 4 <= this->Count; x += 4)
+    {
+        __m128 velocityX = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vx + x), damping4), gx4);
+        __m128 velocityY = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vy + x), damping4), gy4);
+
+        _mm_storeu_ps(vx + x, velocityX);
+        _mm_storeu_ps(vy + x, velocityY);
+        _mm_storeu_ps(px + x, _mm_add_ps(_mm_loadu_ps(px + x), _mm_mul_ps(velocityX, dt4)));
+        _mm_storeu_ps(py + x, _mm_add_ps(_mm_loadu_ps(py + x), _mm_mul_ps(velocityY, dt4)));
+        _mm_storeu_ps(life + x, _mm_sub_ps(_mm_loadu_ps(life + x), dt4));
+    }
+#endif
+
+    // Scalar tail, and the whole range on targets without SSE
+    for (; x < this->Count; x++)
+    {
+        vx[x] = vx[x] * damping + gravityX;
+        vy[x] = vy[x] * damping + gravityY;
+        px[x] += vx[x] * deltaTime;
+        py[x] += vy[x] * deltaTime;
+        life[x] -= deltaTime;
+    }
+}
+
+void CacoEngine::ParticleSystem::Compact()
+{
+    // Swap-remove: the last live particle fills each hole, O(n) with no shifting
+    for (int x = 0; x < this->Count;)
+    {
+        if (this->Life[x] > 0)
+        {
+            x++;
+            continue;
+        }
+
+        int last = --this->Count;
+
+        this->PositionX[x] = this->PositionX[last];
+        this->PositionY[x] = this->PositionY[last];
+        this->VelocityX[x] = this->VelocityX[last];
+        this->VelocityY[x] = this->VelocityY[last];
+        this->Life[x] = this->Life[last];
+        this->InverseLifetime[x] = this->InverseLifetime[last];
+        this->BaseColors[x] = this->BaseColors[last];
+    }
+}
+
+void CacoEngine::ParticleSystem::Update(double deltaTime)
+{
+    for (int x = 0; x < this->Emitters.size(); x++)
+    {
+        ParticleEmitter& emitter = this->Emitters[x];
+
+        if (!emitter.Enabled || emitter.Rate <= 0)
+            continue;
+
+        emitter.Accumulator += emitter.Rate * deltaTime;
+
+        int count = (int)emitter.Accumulator;
+
+        emitter.Accumulator -= count;
+
+        for (int y = 0; y < count && this->Count < this->Capacity; y++)
+            this->Spawn(emitter);
+    }
+
+    this->Integrate((float)deltaTime);
+    this->Compact();
+}
+
+void CacoEngine::ParticleSystem::Draw(Renderer& renderer)
+{
+    if (this->Count == 0)
+        return;
+
+    if (this->Vertices.size() < this->Count * 4)
+        this->Vertices.resize(this->Count * 4);
+
+    // Index pattern never changes, so it is only extended when the batch grows
+    for (int quad = this->Indices.size() / 6; quad < this->Count; quad++)
+    {
+        int base = quad * 4;
+
+        this->Indices.insert(this->Indices.end(), { base, base + 1, base + 2, base + 2, base + 3, base });
+    }
+
+    float half = this->ParticleSize * 0.5f;
+
+    for (int x = 0; x < this->Count; x++)
+    {
+        Color32 color = this->BaseColors[x];
+
+        // Alpha fades linearly with remaining life
+        color.A = (uint8_t)(color.A * std::min(1.0f, this->Life[x] * this->InverseLifetime[x]));
+
+        float x0 = this->PositionX[x] - half, y0 = this->PositionY[x] - half;
+        float x1 = this->PositionX[x] + half, y1 = this->PositionY[x] + half;
+
+        Vertex2Df* quad = &this->Vertices[x * 4];
+
+        quad[0] = Vertex2Df(Point2Df(x0, y0), color, Point2Df(0, 0));
+        quad[1] = Vertex2Df(Point2Df(x1, y0), color, Point2Df(1, 0));
+        quad[2] = Vertex2Df(Point2Df(x1, y1), color, Point2Df(1, 1));
+        quad[3] = Vertex2Df(Point2Df(x0, y1), color, Point2Df(0, 1));
+    }
+
+    renderer.GetFrameStats().BytesConverted += this->Count * 4 * sizeof(Vertex2Df);
+
+    // Untextured geometry uses the draw blend mode, which has to blend for the fade to show
+    SDL_BlendMode blendMode;
+
+    SDL_GetRenderDrawBlendMode(renderer.GetInstance(), &blendMode);
+    SDL_SetRenderDrawBlendMode(renderer.GetInstance(), SDL_BLENDMODE_BLEND);
+
+    renderer.DrawGeometry(this->ParticleTexture.GetInstance(), this->Vertices.data(), this->Count * 4, this->Indices.data(), this->Count * 6);
+
+    SDL_SetRenderDrawBlendMode(renderer.GetInstance(), blendMode);
+}
@@ -0,0 +1,1612 @@
+#include "physicsworld.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <limits>
+
+CacoEngine::BodyPair::BodyPair(int a, int b) : A(a), B(b) {}
+
+CacoEngine::ContactEvent::ContactEvent(ContactEventType type, int a, int b, Point2Df normal, float depth, Point2Df point)
+    : Type(type), A(a), B(b), Normal(normal), Depth(depth), Point(point) {}
+
+CacoEngine::RaycastHit::RaycastHit() : Object(nullptr), Point(Vector2Df()), Normal(Vector2Df()), Fraction(1) {}
+
+// Positions and velocities are doubles, which hold every Q16.16 value exactly, so the fixed-point
+// mode keeps no state of its own between steps and reads values set from outside as they are
+static CacoEngine::FixedVector2 ToFixed(CacoEngine::Vector2Df vector)
+{
+    return CacoEngine::FixedVector2(CacoEngine::Fixed::FromDouble(vector.X), CacoEngine::Fixed::FromDouble(vector.Y));
+}
+
+static CacoEngine::Vector2Df ToVector(CacoEngine::FixedVector2 vector)
+{
+    return CacoEngine::Vector2Df(vector.X.ToDouble(), vector.Y.ToDouble());
+}
+
+// Moves the object onto the position, exactly when both are on the fixed-point grid
+static void MoveTo(CacoEngine::RigidObject2D& object, CacoEngine::FixedVector2 position)
+{
+    CacoEngine::Vector2Df target = ToVector(position);
+
+    object.Translate(CacoEngine::Vector2Df(target.X - object.Position.X, target.Y - object.Position.Y));
+}
+
+// How the solver reads and writes a body in each precision. Fixed values are read off the
+// double state and written back without loss.
+template<typename Scalar>
+struct SolverAccess;
+
+template<>
+struct SolverAccess<double>
+{
+    using Vector = CacoEngine::Vector2Df;
+
+    static double ToScalar(double value) { return value; }
+    static double ToDouble(double value) { return value; }
+
+    static double Sqrt(double value) { return std::sqrt(value); }
+
+    static Vector GetPosition(CacoEngine::RigidObject2D& object) { return object.Position; }
+    static Vector ToVector(CacoEngine::Vector2Df vector) { return vector; }
+
+    static Vector GetVelocity(CacoEngine::RigidObject2D& object) { return object.RigidBody.Velocity; }
+    static void SetVelocity(CacoEngine::RigidObject2D& object, Vector velocity) { object.RigidBody.Velocity = velocity; }
+
+    static void Move(CacoEngine::RigidObject2D& object, double x, double y) { object.Translate(CacoEngine::Vector2Df(x, y)); }
+};
+
+template<>
+struct SolverAccess<CacoEngine::Fixed>
+{
+    using Vector = CacoEngine::FixedVector2;
+
+    static CacoEngine::Fixed ToScalar(double value) { return CacoEngine::Fixed::FromDouble(value); }
+    static double ToDouble(CacoEngine::Fixed value) { return value.ToDouble(); }
+
+    static CacoEngine::Fixed Sqrt(CacoEngine::Fixed value) { return CacoEngine::Fixed::Sqrt(value); }
+
+    static Vector GetPosition(CacoEngine::RigidObject2D& object) { return ToFixed(object.Position); }
+    static Vector ToVector(CacoEngine::Vector2Df vector) { return ToFixed(vector); }
+
+    static Vector GetVelocity(CacoEngine::RigidObject2D& object) { return ToFixed(object.RigidBody.Velocity); }
+    static void SetVelocity(CacoEngine::RigidObject2D& object, Vector velocity) { object.RigidBody.Velocity = ::ToVector(velocity); }
+
+    static void Move(CacoEngine::RigidObject2D& object, CacoEngine::Fixed x, CacoEngine::Fixed y)
+    {
+        MoveTo(object, ToFixed(object.Position) + CacoEngine::FixedVector2(x, y));
+    }
+};
+
+template<typename Scalar>
+static Scalar GetInverseMass(CacoEngine::RigidObject2D& object)
+{
+    Scalar mass = SolverAccess<Scalar>::ToScalar(object.RigidBody.Mass);
+
+    return (mass > Scalar()) ? SolverAccess<Scalar>::ToScalar(1) / mass : Scalar();
+}
+
+// Stops a body falling through the floor, the removed fall presses it down and friction takes
+// that much times its coefficient off its sliding speed
+template<typename Scalar>
+static void StopOnFloor(CacoEngine::RigidObject2D& object)
+{
+    using Access = SolverAccess<Scalar>;
+
+    auto velocity = Access::GetVelocity(object);
+
+    if (velocity.Y <= Scalar())
+        return;
+
+    Scalar limit = Access::ToScalar(object.RigidBody.Friction) * velocity.Y;
+
+    if (velocity.X > limit)
+        velocity.X -= limit;
+    else if (velocity.X < -limit)
+        velocity.X += limit;
+    else
+        velocity.X = Scalar();
+
+    velocity.Y = Scalar();
+
+    Access::SetVelocity(object, velocity);
+}
+
+CacoEngine::PhysicsWorld::PhysicsWorld(std::unique_ptr<Broadphase> broadphase)
+    : Phase(std::move(broadphase)), FiltersChanged(false), Stamp(0), SubstepCount(0), DeepestContact(0), Pool(std::make_unique<ThreadPool>(1)), ProxiesSynced(false), AwakeCount(0),
+      Floor(800), Gravity(Vector2Df()), Integration(IntegrationScheme::SemiImplicitEuler), ResolveContacts(false), SolverIterations(8),
+      PositionIterations(3), WarmStarting(true), RestitutionThreshold(20),
+      Substeps(1), MaxSubstepTime(0), AdaptiveSubsteps(false), AdaptiveTravel(8), AdaptiveDepth(4), MaxSubsteps(8),
+      FixedPoint(false), AllowSleeping(true), SleepVelocity(5), TimeToSleep(0.5)
+{
+    if (!this->Phase)
+        this->Phase = std::make_unique<SpatialHashBroadphase>();
+
+    std::fill(std::begin(this->LayerMatrix), std::end(this->LayerMatrix), 0xFFFFFFFF);
+}
+
+void CacoEngine::PhysicsWorld::SetLayerCollision(int first, int second, bool collides)
+{
+    if (first < 0 || first >= 32 || second < 0 || second >= 32)
+        return;
+
+    if (collides)
+    {
+        this->LayerMatrix[first] |= (uint32_t)1 << second;
+        this->LayerMatrix[second] |= (uint32_t)1 << first;
+    }
+    else
+    {
+        this->LayerMatrix[first] &= ~((uint32_t)1 << second);
+        this->LayerMatrix[second] &= ~((uint32_t)1 << first);
+    }
+
+    this->FiltersChanged = true;
+}
+
+bool CacoEngine::PhysicsWorld::GetLayerCollision(int first, int second)
+{
+    if (first < 0 || first >= 32 || second < 0 || second >= 32)
+        return false;
+
+    return this->LayerMatrix[first] & ((uint32_t)1 << second);
+}
+
+uint32_t CacoEngine::PhysicsWorld::GetFilterMask(RigidObject2D& object)
+{
+    uint32_t layers = 0;
+
+    // Usually a single category bit, so this stops after a few rounds
+    for (int bit = 0; bit < 32 && (object.CollisionCategory >> bit); bit++)
+        if ((object.CollisionCategory >> bit) & 1)
+            layers |= this->LayerMatrix[bit];
+
+    return object.CollisionMask & layers;
+}
+
+void CacoEngine::PhysicsWorld::SetThreadCount(int threads)
+{
+    this->Pool = std::make_unique<ThreadPool>(threads);
+}
+
+int CacoEngine::PhysicsWorld::GetThreadCount()
+{
+    return this->Pool->GetThreadCount();
+}
+
+CacoEngine::PhysicsWorld::~PhysicsWorld() {}
+
+void CacoEngine::PhysicsWorld::SetBroadphase(std::unique_ptr<Broadphase> broadphase)
+{
+    if (!broadphase)
+        return;
+
+    this->Phase = std::move(broadphase);
+
+    this->Proxies.clear();
+    this->ProxyOwners.clear();
+    this->ProxyObjectIDs.clear();
+    this->ProxyIndex.clear();
+    this->ProxyStamp.clear();
+    this->ProxyState.clear();
+    this->ProxyCategory.clear();
+    this->ProxyMask.clear();
+    this->RestingPartners.clear();
+    this->ObjectProxies.clear();
+
+    this->ProxiesSynced = false;
+
+    // Proxy IDs change with the backend, pairs touching across the switch begin again
+    this->ActivePairs.clear();
+    this->Impulses.clear();
+}
+
+CacoEngine::Broadphase& CacoEngine::PhysicsWorld::GetBroadphase()
+{
+    return *this->Phase;
+}
+
+void CacoEngine::PhysicsWorld::SyncProxies(std::vector<std::shared_ptr<RigidObject2D>>& objects)
+{
+    this->Stamp++;
+
+    this->ObjectProxies.resize(objects.size(), -1);
+    this->ObjectBounds.resize(objects.size());
+    this->SyncObjects.clear();
+
+    int synced = 0;
+
+    for (int x = 0; x < objects.size(); x++)
+    {
+        RigidObject2D* object = objects[x].get();
+        RigidBody2D& body = object->RigidBody;
+
+        uint64_t id = object->GetPhysicsID();
+
+        // Objects mostly stay at the same index, which saves the lookup
+        int proxy = this->ObjectProxies[x];
+
+        if (proxy < 0 || proxy >= this->ProxyObjectIDs.size() || !this->ProxyOwners[proxy] || this->ProxyObjectIDs[proxy] != id)
+        {
+            auto it = this->Proxies.find(id);
+
+            if (it != this->Proxies.end())
+                proxy = it->second;
+            else
+            {
+                this->ObjectBounds[x] = object->GetBounds();
+
+                proxy = this->Phase->CreateProxy(this->ObjectBounds[x]);
+
+                this->Proxies.emplace(id, proxy);
+
+                if (proxy >= this->ProxyOwners.size())
+                {
+                    this->ProxyOwners.resize(proxy + 1, nullptr);
+                    this->ProxyObjectIDs.resize(proxy + 1, 0);
+                    this->ProxyIndex.resize(proxy + 1, -1);
+                    this->ProxyStamp.resize(proxy + 1, 0);
+                    this->ProxyState.resize(proxy + 1, ProxyNew);
+                    this->ProxyCategory.resize(proxy + 1, 0);
+                    this->ProxyMask.resize(proxy + 1, 0);
+                    this->RestingPartners.resize(proxy + 1);
+                }
+
+                this->ProxyOwners[proxy] = object;
+                this->ProxyObjectIDs[proxy] = id;
+                this->ProxyState[proxy] = ProxyNew;
+
+                // Forces the filter below
+                this->ProxyCategory[proxy] = ~object->CollisionCategory;
+            }
+        }
+
+        if (this->ProxyStamp[proxy] != this->Stamp)
+            synced++;
+
+        this->ProxyIndex[proxy] = x;
+        this->ProxyStamp[proxy] = this->Stamp;
+        this->ObjectProxies[x] = proxy;
+
+        uint8_t state = body.Sleeping ? ProxySleeping : ((body.Mass <= 0) ? ProxyImmovable : ProxyMoving);
+
+        if (state != this->ProxyState[proxy])
+        {
+            this->Phase->SetProxyResting(proxy, body.Sleeping);
+
+            // Whether its pairs rest may have changed with it
+            this->ReleaseRestingPairs(proxy);
+
+            this->ProxyState[proxy] = state;
+        }
+
+        if (!body.Sleeping)
+            this->SyncObjects.push_back(x);
+
+        if (this->FiltersChanged || object->CollisionCategory != this->ProxyCategory[proxy] || object->CollisionMask != this->ProxyMask[proxy])
+        {
+            this->Phase->SetProxyFilter(proxy, object->CollisionCategory, this->GetFilterMask(*object));
+
+            this->ProxyCategory[proxy] = object->CollisionCategory;
+            this->ProxyMask[proxy] = object->CollisionMask;
+        }
+    }
+
+    this->FiltersChanged = false;
+
+    this->Pool->ParallelFor(this->SyncObjects.size(), 1024, [&](int begin, int end, int thread)
+    {
+        for (int x = begin; x < end; x++)
+            this->ObjectBounds[this->SyncObjects[x]] = objects[this->SyncObjects[x]]->GetBounds();
+    });
+
+    for (int x = 0; x < this->SyncObjects.size(); x++)
+        this->Phase->MoveProxy(this->ObjectProxies[this->SyncObjects[x]], this->ObjectBounds[this->SyncObjects[x]]);
+
+    // Objects that left the list since the last update, only searched for when some did
+    if (synced == this->Proxies.size())
+        return;
+
+    for (int x = 0; x < this->ProxyOwners.size(); x++)
+        if (this->ProxyOwners[x] && this->ProxyStamp[x] != this->Stamp)
+        {
+            this->ReleaseRestingPairs(x);
+
+            this->Phase->DestroyProxy(x);
+            this->Proxies.erase(this->ProxyObjectIDs[x]);
+
+            this->ProxyOwners[x] = nullptr;
+            this->ProxyIndex[x] = -1;
+        }
+}
+
+void CacoEngine::PhysicsWorld::SetPairResting(int first, int second)
+{
+    this->RestingPartners[first].push_back(second);
+    this->RestingPartners[second].push_back(first);
+}
+
+void CacoEngine::PhysicsWorld::ReleaseRestingPairs(int proxy)
+{
+    std::vector<int>& partners = this->RestingPartners[proxy];
+
+    for (int x = 0; x < partners.size(); x++)
+    {
+        std::vector<int>& other = this->RestingPartners[partners[x]];
+
+        auto it = std::find(other.begin(), other.end(), proxy);
+
+        if (it != other.end())
+            other.erase(it);
+
+        this->ActivePairs.insert(((uint64_t)std::min(proxy, partners[x]) << 32) | std::max(proxy, partners[x]));
+    }
+
+    partners.clear();
+}
+
+const std::vector<CacoEngine::BodyPair>& CacoEngine::PhysicsWorld::UpdatePairs(std::vector<std::shared_ptr<RigidObject2D>>& objects)
+{
+    if (!this->ProxiesSynced)
+        this->SyncProxies(objects);
+
+    this->ProxiesSynced = false;
+
+    this->Phase->FindPairs(this->ProxyPairs, *this->Pool);
+
+    this->Pairs.clear();
+
+    for (int x = 0; x < this->ProxyPairs.size(); x++)
+    {
+        int a = this->ProxyIndex[this->ProxyPairs[x].A], b = this->ProxyIndex[this->ProxyPairs[x].B];
+
+        this->Pairs.emplace_back(std::min(a, b), std::max(a, b));
+    }
+
+    std::sort(this->Pairs.begin(), this->Pairs.end(), [](const BodyPair& first, const BodyPair& second)
+    {
+        return (first.A != second.A) ? first.A < second.A : first.B < second.B;
+    });
+
+    return this->Pairs;
+}
+
+const std::vector<CacoEngine::BodyPair>& CacoEngine::PhysicsWorld::GetPairs()
+{
+    return this->Pairs;
+}
+
+const std::vector<CacoEngine::Contact>& CacoEngine::PhysicsWorld::UpdateContacts(std::vector<std::shared_ptr<RigidObject2D>>& objects)
+{
+    this->UpdatePairs(objects);
+
+    if (this->FixedPoint)
+    {
+        this->CollideFixed(objects);
+        this->UpdateEvents();
+
+        return this->Contacts;
+    }
+
+    this->Shapes.Clear();
+    this->ShapeObjects.clear();
+    this->ShapePairs.clear();
+
+    this->ObjectShapes.resize(objects.size(), -1);
+
+    for (int x = 0; x < this->Pairs.size(); x++)
+    {
+        int ends[2] = { this->Pairs[x].A, this->Pairs[x].B };
+
+        if (IsRestingPair(*objects[ends[0]], *objects[ends[1]]))
+            continue;
+
+        for (int y = 0; y < 2; y++)
+            if (this->ObjectShapes[ends[y]] < 0)
+            {
+                this->ObjectShapes[ends[y]] = objects[ends[y]]->AddShape(this->Shapes);
+                this->ShapeObjects.push_back(ends[y]);
+            }
+
+        this->ShapePairs.emplace_back(this->ObjectShapes[ends[0]], this->ObjectShapes[ends[1]]);
+    }
+
+    this->Shapes.Collide(this->ShapePairs, this->Contacts, *this->Pool);
+
+    for (int x = 0; x < this->Contacts.size(); x++)
+    {
+        this->Contacts[x].A = this->ShapeObjects[this->Contacts[x].A];
+        this->Contacts[x].B = this->ShapeObjects[this->Contacts[x].B];
+    }
+
+    // Cleared one by one rather than refilled, most objects never get a shape
+    for (int x = 0; x < this->ShapeObjects.size(); x++)
+        this->ObjectShapes[this->ShapeObjects[x]] = -1;
+
+    std::sort(this->Contacts.begin(), this->Contacts.end(), [](const Contact& first, const Contact& second)
+    {
+        return (first.A != second.A) ? first.A < second.A : first.B < second.B;
+    });
+
+    this->UpdateEvents();
+
+    return this->Contacts;
+}
+
+bool CacoEngine::PhysicsWorld::TestFixed(const FixedShape& a, const FixedShape& b, Contact* contact)
+{
+    if (a.Round && b.Round)
+        return Narrowphase::TestCircles(a.Center, a.Radius, b.Center, b.Radius, contact);
+
+    if (a.Round)
+        return Narrowphase::TestCircleBox(a.Center, a.Radius, b.Box, contact);
+
+    if (!b.Round)
+        return Narrowphase::TestBoxes(a.Box, b.Box, contact);
+
+    if (!Narrowphase::TestCircleBox(b.Center, b.Radius, a.Box, contact))
+        return false;
+
+    // Tested from the circle's side, the normal has to point from A to B
+    if (contact)
+        contact->Normal = Point2Df(-contact->Normal.X, -contact->Normal.Y);
+
+    return true;
+}
+
+void CacoEngine::PhysicsWorld::CollideFixed(std::vector<std::shared_ptr<RigidObject2D>>& objects)
+{
+    this->ShapeObjects.clear();
+    this->ObjectShapes.resize(objects.size(), -1);
+
+    // Only objects in a pair are converted, sleeping piles would otherwise cost a shape each
+    for (int x = 0; x < this->Pairs.size(); x++)
+    {
+        int ends[2] = { this->Pairs[x].A, this->Pairs[x].B };
+
+        if (IsRestingPair(*objects[ends[0]], *objects[ends[1]]))
+            continue;
+
+        for (int y = 0; y < 2; y++)
+            if (this->ObjectShapes[ends[y]] < 0)
+            {
+                this->ObjectShapes[ends[y]] = this->ShapeObjects.size();
+                this->ShapeObjects.push_back(ends[y]);
+            }
+    }
+
+    this->FixedShapes.resize(this->ShapeObjects.size());
+
+    this->Pool->ParallelFor(this->ShapeObjects.size(), 1024, [&](int begin, int end, int thread)
+    {
+        for (int x = begin; x < end; x++)
+        {
+            RigidObject2D& object = *objects[this->ShapeObjects[x]];
+            FixedShape& shape = this->FixedShapes[x];
+
+            RigidCircle* circle = dynamic_cast<RigidCircle*>(&object);
+
+            shape.Round = (circle != nullptr);
+            shape.Center = ToFixed(object.Position);
+
+            if (circle)
+            {
+                shape.Radius = Fixed::FromDouble(circle->GetRadius());
+                continue;
+            }
+
+            // The mesh is in floats, only its extent around the position is taken from it
+            AABB bounds = object.GetBounds();
+
+            shape.Box = FixedAABB(shape.Center.X + Fixed::FromDouble(bounds.MinX - object.Position.X),
+                                  shape.Center.Y + Fixed::FromDouble(bounds.MinY - object.Position.Y),
+                                  shape.Center.X + Fixed::FromDouble(bounds.MaxX - object.Position.X),
+                                  shape.Center.Y + Fixed::FromDouble(bounds.MaxY - object.Position.Y));
+        }
+    });
+
+    // A slot per pair keeps the output in pair order whichever thread tests it
+    this->PairContacts.resize(this->Pairs.size());
+    this->PairHits.assign(this->Pairs.size(), 0);
+
+    this->Pool->ParallelFor(this->Pairs.size(), 256, [&](int begin, int end, int thread)
+    {
+        for (int x = begin; x < end; x++)
+        {
+            const BodyPair& pair = this->Pairs[x];
+
+            if (IsRestingPair(*objects[pair.A], *objects[pair.B]))
+                continue;
+
+            Contact& contact = this->PairContacts[x];
+
+            if (!TestFixed(this->FixedShapes[this->ObjectShapes[pair.A]], this->FixedShapes[this->ObjectShapes[pair.B]], &contact))
+                continue;
+
+            contact.A = pair.A;
+            contact.B = pair.B;
+
+            this->PairHits[x] = 1;
+        }
+    });
+
+    this->Contacts.clear();
+
+    for (int x = 0; x < this->Pairs.size(); x++)
+        if (this->PairHits[x])
+            this->Contacts.push_back(this->PairContacts[x]);
+
+    for (int x = 0; x < this->ShapeObjects.size(); x++)
+        this->ObjectShapes[this->ShapeObjects[x]] = -1;
+}
+
+void CacoEngine::PhysicsWorld::UpdateEvents()
+{
+    this->Events.clear();
+    this->CurrentPairs.clear();
+
+    for (int x = 0; x < this->Contacts.size(); x++)
+    {
+        const Contact& contact = this->Contacts[x];
+
+        uint64_t key = this->GetPairKey(contact);
+
+        this->CurrentPairs.insert(key);
+
+        // Erasing leaves only the pairs that stopped touching behind
+        ContactEventType type = this->ActivePairs.erase(key) ? ContactEventType::Stay : ContactEventType::Begin;
+
+        this->Events.emplace_back(type, contact.A, contact.B, contact.Normal, contact.Depth, contact.Point);
+    }
+
+    int ended = this->Events.size();
+
+    for (uint64_t key : this->ActivePairs)
+    {
+        int proxies[2] = { (int)(key >> 32), (int)(key & 0xFFFFFFFF) };
+        int indices[2];
+
+        for (int y = 0; y < 2; y++)
+            indices[y] = (proxies[y] < this->ProxyOwners.size() && this->ProxyOwners[proxies[y]]) ? this->ProxyIndex[proxies[y]] : -1;
+
+        // Skipped rather than separated, the pair is set aside until one side changes state
+        if (indices[0] >= 0 && indices[1] >= 0 && IsRestingPair(*this->ProxyOwners[proxies[0]], *this->ProxyOwners[proxies[1]]))
+        {
+            this->SetPairResting(proxies[0], proxies[1]);
+            continue;
+        }
+
+        this->Events.emplace_back(ContactEventType::End, std::min(indices[0], indices[1]), std::max(indices[0], indices[1]));
+    }
+
+    // Hash order isn't stable, sort so replays see the same sequence
+    std::sort(this->Events.begin() + ended, this->Events.end(), [](const ContactEvent& first, const ContactEvent& second)
+    {
+        return (first.A != second.A) ? first.A < second.A : first.B < second.B;
+    });
+
+    std::swap(this->ActivePairs, this->CurrentPairs);
+}
+
+void CacoEngine::PhysicsWorld::Integrate(std::vector<std::shared_ptr<RigidObject2D>>& objects, double deltaTime)
+{
+    this->BodyObjects.clear();
+    this->SweptObjects.clear();
+    this->SweepStarts.clear();
+
+    for (int x = 0; x < objects.size(); x++)
+    {
+        RigidBody2D& body = objects[x]->RigidBody;
+
+        // Immovable objects never move, and Force / Mass would be infinite
+        if (body.Mass <= 0)
+        {
+            body.Force = Vector2Df(0, 0);
+            continue;
+        }
+
+        if (body.Sleeping)
+        {
+            // Its velocity was zeroed when it fell asleep, so any other was set from outside since
+            if (body.Velocity == Vector2Df(0, 0))
+                continue;
+
+            body.Wake();
+        }
+
+        this->BodyObjects.push_back(x);
+
+        if (body.ContinuousCollision)
+        {
+            this->SweptObjects.push_back(x);
+            this->SweepStarts.emplace_back(objects[x]->Position.X, objects[x]->Position.Y);
+        }
+    }
+
+    this->AwakeCount = this->BodyObjects.size();
+
+    if (this->FixedPoint)
+    {
+        this->FixedBodies.Scheme = this->Integration;
+        this->FixedBodies.Gravity = ToFixed(this->Gravity);
+        this->FixedBodies.Resize(this->AwakeCount);
+
+        this->Pool->ParallelFor(this->AwakeCount, 1024, [&](int begin, int end, int thread)
+        {
+            for (int x = begin; x < end; x++)
+            {
+                RigidObject2D& object = *objects[this->BodyObjects[x]];
+
+                this->FixedBodies.SetPosition(x, ToFixed(object.Position));
+                this->FixedBodies.SetVelocity(x, ToFixed(object.RigidBody.Velocity));
+                this->FixedBodies.SetForce(x, ToFixed(object.RigidBody.Force));
+                this->FixedBodies.SetMass(x, Fixed::FromDouble(object.RigidBody.Mass));
+            }
+        });
+
+        this->FixedBodies.Integrate(Fixed::FromDouble(deltaTime), *this->Pool);
+    }
+    else
+    {
+        this->Bodies.Scheme = this->Integration;
+        this->Bodies.Gravity = this->Gravity;
+        this->Bodies.Resize(this->AwakeCount);
+
+        this->Pool->ParallelFor(this->AwakeCount, 1024, [&](int begin, int end, int thread)
+        {
+            for (int x = begin; x < end; x++)
+            {
+                RigidObject2D& object = *objects[this->BodyObjects[x]];
+
+                this->Bodies.SetPosition(x, object.Position);
+                this->Bodies.SetVelocity(x, object.RigidBody.Velocity);
+                this->Bodies.SetForce(x, object.RigidBody.Force);
+                this->Bodies.SetMass(x, object.RigidBody.Mass);
+            }
+        });
+
+        this->Bodies.Integrate(deltaTime, *this->Pool);
+    }
+
+    this->Pool->ParallelFor(this->AwakeCount, 1024, [&](int begin, int end, int thread)
+    {
+        for (int x = begin; x < end; x++)
+        {
+            RigidObject2D& object = *objects[this->BodyObjects[x]];
+            RigidBody2D& body = object.RigidBody;
+
+            if (this->FixedPoint)
+            {
+                MoveTo(object, this->FixedBodies.GetPosition(x));
+
+                body.Velocity = ToVector(this->FixedBodies.GetVelocity(x));
+            }
+            else
+            {
+                Vector2Df position = this->Bodies.GetPosition(x);
+
+                object.Translate(Vector2Df(position.X - object.Position.X, position.Y - object.Position.Y));
+
+                body.Velocity = this->Bodies.GetVelocity(x);
+            }
+
+            body.UpdateAcceleration();
+            body.Acceleration += this->Gravity;
+            body.Force = Vector2Df(0, 0);
+
+            body.LastUpdate = deltaTime;
+
+            this->ApplyFloor(object);
+        }
+    });
+}
+
+double CacoEngine::PhysicsWorld::GetFloorHeight()
+{
+    // On the grid in fixed-point mode, so the floor doesn't knock positions off it
+    return this->FixedPoint ? Fixed::FromDouble(this->Floor).ToDouble() : this->Floor;
+}
+
+void CacoEngine::PhysicsWorld::ApplyFloor(RigidObject2D& object)
+{
+    double floor = this->GetFloorHeight();
+
+    if (object.Position.Y <= floor)
+        return;
+
+    object.Translate(Vector2Df(0, -(object.Position.Y - floor)));
+
+    // Stopped as well as moved, so bodies can come to rest there
+    if (this->FixedPoint)
+        StopOnFloor<Fixed>(object);
+    else
+        StopOnFloor<double>(object);
+}
+
+void CacoEngine::PhysicsWorld::SweepBodies(std::vector<std::shared_ptr<RigidObject2D>>& objects)
+{
+    this->ImpactObjects.clear();
+
+    if (this->SweptObjects.empty())
+        return;
+
+    // Targets are tested where they ended up this step
+    this->SyncProxies(objects);
+    this->ProxiesSynced = true;
+
+    for (int x = 0; x < this->SweptObjects.size(); x++)
+    {
+        int index = this->SweptObjects[x];
+
+        RigidObject2D& object = *objects[index];
+
+        Point2Df start = this->SweepStarts[x], end(object.Position.X, object.Position.Y);
+        Point2Df offset(end.X - start.X, end.Y - start.Y);
+
+        float length = std::sqrt(offset.X * offset.X + offset.Y * offset.Y);
+
+        if (length <= 0)
+            continue;
+
+        AABB bounds = this->ObjectBounds[index];
+        AABB startBounds(bounds.MinX - offset.X, bounds.MinY - offset.Y, bounds.MaxX - offset.X, bounds.MaxY - offset.Y);
+
+        RigidCircle* circle = dynamic_cast<RigidCircle*>(&object);
+
+        this->QueryResults.clear();
+        this->Phase->QueryRegion(startBounds.Merge(bounds), this->QueryResults);
+
+        float earliest = 1;
+        bool hit = false;
+
+        // Pointing from the object to what it hit
+        Point2Df normal;
+
+        for (int y = 0; y < this->QueryResults.size(); y++)
+        {
+            RigidObject2D* other = this->ProxyOwners[this->QueryResults[y]];
+
+            if (other == &object || !this->Phase->CanPair(this->ObjectProxies[index], this->QueryResults[y]))
+                continue;
+
+            RigidCircle* otherCircle = dynamic_cast<RigidCircle*>(other);
+
+            float fraction;
+            bool touches;
+
+            Point2Df touchNormal;
+            Contact overlap;
+
+            if (circle && otherCircle)
+            {
+                Point2Df center(otherCircle->Position.X, otherCircle->Position.Y);
+
+                touches = Narrowphase::SweepCircles(start, end, circle->GetRadius(), center, otherCircle->GetRadius(), &fraction, &touchNormal);
+
+                if (!touches && !this->ResolveContacts && Narrowphase::TestCircles(start, circle->GetRadius(), center, otherCircle->GetRadius(), &overlap))
+                    touchNormal = overlap.Normal;
+            }
+            else if (circle)
+            {
+                touches = Narrowphase::SweepCircleBox(start, end, circle->GetRadius(), other->GetBounds(), &fraction, &touchNormal);
+
+                if (!touches && !this->ResolveContacts && Narrowphase::TestCircleBox(start, circle->GetRadius(), other->GetBounds(), &overlap))
+                    touchNormal = overlap.Normal;
+            }
+            else if (otherCircle)
+            {
+                // Same motion seen from the box, the circle moves the opposite way
+                Point2Df center(otherCircle->Position.X, otherCircle->Position.Y);
+
+                touches = Narrowphase::SweepCircleBox(center, Point2Df(center.X - offset.X, center.Y - offset.Y), otherCircle->GetRadius(), startBounds, &fraction, &touchNormal);
+
+                if (!touches && !this->ResolveContacts && Narrowphase::TestCircleBox(center, otherCircle->GetRadius(), startBounds, &overlap))
+                    touchNormal = overlap.Normal;
+
+                touchNormal = Point2Df(-touchNormal.X, -touchNormal.Y);
+            }
+            else
+            {
+                touches = Narrowphase::SweepBoxes(startBounds, offset, other->GetBounds(), &fraction, &touchNormal);
+
+                if (!touches && !this->ResolveContacts && Narrowphase::TestBoxes(startBounds, other->GetBounds(), &overlap))
+                    touchNormal = overlap.Normal;
+            }
+
+            // Nothing pushes apart objects that start out overlapping without the solver,
+            // so moving further in is stopped right away
+            if (!touches && !this->ResolveContacts && offset.X * touchNormal.X + offset.Y * touchNormal.Y > 0)
+            {
+                touches = true;
+                fraction = 0;
+            }
+
+            if (touches && fraction < earliest)
+            {
+                earliest = fraction;
+                normal = touchNormal;
+                hit = true;
+            }
+        }
+
+        if (!hit)
+            continue;
+
+        float backX, backY;
+
+        if (this->ResolveContacts)
+        {
+            // The rest of the motion is dropped, the contact and solver take it from there
+            float advance = std::min(earliest + ImpactDepth / length, 1.0f);
+
+            backX = offset.X * (advance - 1);
+            backY = offset.Y * (advance - 1);
+
+            this->ImpactObjects.push_back(index);
+        }
+        else
+        {
+            // No contact will stop it, so the object halts at the surface with the motion and
+            // velocity into it removed, and slides along it for the rest of the step
+            float into = (offset.X * normal.X + offset.Y * normal.Y) * (1 - earliest);
+
+            backX = -normal.X * into;
+            backY = -normal.Y * into;
+
+            RigidBody2D& body = object.RigidBody;
+
+            float approach = body.Velocity.X * normal.X + body.Velocity.Y * normal.Y;
+
+            if (approach > 0)
+                body.Velocity -= Vector2Df(normal.X * approach, normal.Y * approach);
+        }
+
+        object.Translate(Vector2Df(backX, backY));
+
+        this->ObjectBounds[index] = AABB(bounds.MinX + backX, bounds.MinY + backY, bounds.MaxX + backX, bounds.MaxY + backY);
+        this->Phase->MoveProxy(this->ObjectProxies[index], this->ObjectBounds[index]);
+    }
+}
+
+void CacoEngine::PhysicsWorld::ColorContacts(std::vector<std::shared_ptr<RigidObject2D>>& objects)
+{
+    // Greedy in contact order, which is sorted, so the grouping never depends on threads
+    this->BodyColors.resize(objects.size(), 0);
+    this->ContactColors.resize(this->Contacts.size());
+    this->ColorStart.assign(OverflowColor + 2, 0);
+
+    for (int x = 0; x < this->Contacts.size(); x++)
+    {
+        int a = this->Contacts[x].A, b = this->Contacts[x].B;
+
+        // Immovable objects are never written, any number of contacts may share them
+        bool movesA = objects[a]->RigidBody.Mass > 0, movesB = objects[b]->RigidBody.Mass > 0;
+
+        uint64_t used = (movesA ? this->BodyColors[a] : 0) | (movesB ? this->BodyColors[b] : 0);
+
+        int color = OverflowColor;
+
+        for (int y = 0; y < OverflowColor; y++)
+            if (!(used & ((uint64_t)1 << y)))
+            {
+                color = y;
+                break;
+            }
+
+        if (color != OverflowColor)
+        {
+            if (movesA)
+                this->BodyColors[a] |= (uint64_t)1 << color;
+
+            if (movesB)
+                this->BodyColors[b] |= (uint64_t)1 << color;
+        }
+
+        this->ContactColors[x] = color;
+        this->ColorStart[color + 1]++;
+    }
+
+    for (int x = 1; x < this->ColorStart.size(); x++)
+        this->ColorStart[x] += this->ColorStart[x - 1];
+
+    this->ColorOrder.resize(this->Contacts.size());
+
+    std::vector<int> next(this->ColorStart.begin(), this->ColorStart.end() - 1);
+
+    for (int x = 0; x < this->Contacts.size(); x++)
+        this->ColorOrder[next[this->ContactColors[x]]++] = x;
+
+    // Only contact ends were colored, clearing those leaves the rest zero for the next substep
+    for (int x = 0; x < this->Contacts.size(); x++)
+    {
+        this->BodyColors[this->Contacts[x].A] = 0;
+        this->BodyColors[this->Contacts[x].B] = 0;
+    }
+}
+
+uint64_t CacoEngine::PhysicsWorld::GetPairKey(const Contact& contact)
+{
+    uint32_t first = this->ObjectProxies[contact.A], second = this->ObjectProxies[contact.B];
+
+    return ((uint64_t)std::min(first, second) << 32) | std::max(first, second);
+}
+
+template<typename Function>
+void CacoEngine::PhysicsWorld::ForEachColor(Function function)
+{
+    for (int color = 0; color <= OverflowColor; color++)
+    {
+        int start = this->ColorStart[color], count = this->ColorStart[color + 1] - start;
+
+        // Overflow contacts may share bodies, one chunk keeps them on a single thread
+        int chunk = (color == OverflowColor) ? std::max(count, 1) : 256;
+
+        this->Pool->ParallelFor(count, chunk, [&](int begin, int end, int thread)
+        {
+            for (int x = begin; x < end; x++)
+                function(this->ColorOrder[start + x]);
+        });
+    }
+}
+
+template<typename Scalar>
+void CacoEngine::PhysicsWorld::PrepareContact(int index, std::vector<std::shared_ptr<RigidObject2D>>& objects)
+{
+    using Access = SolverAccess<Scalar>;
+
+    const Contact& contact = this->Contacts[index];
+    ContactConstraint& constraint = this->Constraints[index];
+
+    RigidObject2D& a = *objects[contact.A];
+    RigidObject2D& b = *objects[contact.B];
+
+    constraint.NormalImpulse = 0;
+    constraint.TangentImpulse = 0;
+
+    if (this->WarmStarting)
+    {
+        auto cached = this->Impulses.find(this->GetPairKey(contact));
+
+        if (cached != this->Impulses.end())
+        {
+            constraint.NormalImpulse = cached->second.Normal;
+            constraint.TangentImpulse = cached->second.Tangent;
+        }
+    }
+
+    constraint.Friction = Access::ToDouble(Access::Sqrt(Access::ToScalar(a.RigidBody.Friction) * Access::ToScalar(b.RigidBody.Friction)));
+
+    // Restitution works off the approach speed before any impulse of this solve
+    Scalar normalX = Access::ToScalar(contact.Normal.X), normalY = Access::ToScalar(contact.Normal.Y);
+
+    auto velocityA = Access::GetVelocity(a);
+    auto velocityB = Access::GetVelocity(b);
+
+    Scalar approach = (velocityB.X - velocityA.X) * normalX + (velocityB.Y - velocityA.Y) * normalY;
+    Scalar restitution = std::max(Access::ToScalar(a.RigidBody.Restitution), Access::ToScalar(b.RigidBody.Restitution));
+
+    constraint.Bounce = (approach < -Access::ToScalar(this->RestitutionThreshold)) ? Access::ToDouble(-restitution * approach) : 0;
+}
+
+template<typename Scalar>
+void CacoEngine::PhysicsWorld::WarmStartContact(int index, std::vector<std::shared_ptr<RigidObject2D>>& objects)
+{
+    using Access = SolverAccess<Scalar>;
+
+    const Contact& contact = this->Contacts[index];
+    const ContactConstraint& constraint = this->Constraints[index];
+
+    RigidObject2D& a = *objects[contact.A];
+    RigidObject2D& b = *objects[contact.B];
+
+    Scalar inverseA = GetInverseMass<Scalar>(a), inverseB = GetInverseMass<Scalar>(b);
+
+    Scalar normalX = Access::ToScalar(contact.Normal.X), normalY = Access::ToScalar(contact.Normal.Y);
+    Scalar normalImpulse = Access::ToScalar(constraint.NormalImpulse), tangentImpulse = Access::ToScalar(constraint.TangentImpulse);
+
+    // The tangent is the normal turned a quarter clockwise
+    Scalar impulseX = normalX * normalImpulse - normalY * tangentImpulse;
+    Scalar impulseY = normalY * normalImpulse + normalX * tangentImpulse;
+
+    if (inverseA > Scalar())
+    {
+        auto velocity = Access::GetVelocity(a);
+
+        velocity.X -= impulseX * inverseA;
+        velocity.Y -= impulseY * inverseA;
+
+        Access::SetVelocity(a, velocity);
+    }
+
+    if (inverseB > Scalar())
+    {
+        auto velocity = Access::GetVelocity(b);
+
+        velocity.X += impulseX * inverseB;
+        velocity.Y += impulseY * inverseB;
+
+        Access::SetVelocity(b, velocity);
+    }
+}
+
+template<typename Scalar>
+void CacoEngine::PhysicsWorld::SolveContact(int index, std::vector<std::shared_ptr<RigidObject2D>>& objects)
+{
+    using Access = SolverAccess<Scalar>;
+
+    const Contact& contact = this->Contacts[index];
+    ContactConstraint& constraint = this->Constraints[index];
+
+    RigidObject2D& a = *objects[contact.A];
+    RigidObject2D& b = *objects[contact.B];
+
+    Scalar inverseA = GetInverseMass<Scalar>(a), inverseB = GetInverseMass<Scalar>(b);
+    Scalar inverseSum = inverseA + inverseB;
+
+    if (inverseSum == Scalar())
+        return;
+
+    Scalar normalX = Access::ToScalar(contact.Normal.X), normalY = Access::ToScalar(contact.Normal.Y);
+    Scalar tangentX = -normalY, tangentY = normalX;
+
+    auto velocityA = Access::GetVelocity(a);
+    auto velocityB = Access::GetVelocity(b);
+
+    // Friction first, bounded by the normal impulse so far
+    Scalar tangentImpulse = Access::ToScalar(constraint.TangentImpulse);
+    Scalar limit = Access::ToScalar(constraint.Friction) * Access::ToScalar(constraint.NormalImpulse);
+
+    Scalar slide = (velocityB.X - velocityA.X) * tangentX + (velocityB.Y - velocityA.Y) * tangentY;
+    Scalar total = std::min(std::max(tangentImpulse - slide / inverseSum, -limit), limit);
+    Scalar impulse = total - tangentImpulse;
+
+    constraint.TangentImpulse = Access::ToDouble(total);
+
+    velocityA.X -= tangentX * impulse * inverseA;
+    velocityA.Y -= tangentY * impulse * inverseA;
+    velocityB.X += tangentX * impulse * inverseB;
+    velocityB.Y += tangentY * impulse * inverseB;
+
+    // Then the normal, accumulated rather than per pass so it may shrink again but never pull
+    Scalar normalImpulse = Access::ToScalar(constraint.NormalImpulse);
+
+    Scalar separation = (velocityB.X - velocityA.X) * normalX + (velocityB.Y - velocityA.Y) * normalY;
+
+    total = std::max(normalImpulse + (Access::ToScalar(constraint.Bounce) - separation) / inverseSum, Scalar());
+    impulse = total - normalImpulse;
+
+    constraint.NormalImpulse = Access::ToDouble(total);
+
+    velocityA.X -= normalX * impulse * inverseA;
+    velocityA.Y -= normalY * impulse * inverseA;
+    velocityB.X += normalX * impulse * inverseB;
+    velocityB.Y += normalY * impulse * inverseB;
+
+    if (inverseA > Scalar())
+        Access::SetVelocity(a, velocityA);
+
+    if (inverseB > Scalar())
+        Access::SetVelocity(b, velocityB);
+}
+
+template<typename Scalar>
+void CacoEngine::PhysicsWorld::CorrectContact(int index, std::vector<std::shared_ptr<RigidObject2D>>& objects)
+{
+    using Access = SolverAccess<Scalar>;
+
+    const Contact& contact = this->Contacts[index];
+
+    RigidObject2D& a = *objects[contact.A];
+    RigidObject2D& b = *objects[contact.B];
+
+    Scalar normalX = Access::ToScalar(contact.Normal.X), normalY = Access::ToScalar(contact.Normal.Y);
+
+    // A body on the floor takes a push down into it like an immovable one, the other body moves
+    // the whole way instead of half of it being undone by the floor
+    Scalar inverseA = (this->OnFloor[contact.A] && normalY < Scalar()) ? Scalar() : GetInverseMass<Scalar>(a);
+    Scalar inverseB = (this->OnFloor[contact.B] && normalY > Scalar()) ? Scalar() : GetInverseMass<Scalar>(b);
+    Scalar inverseSum = inverseA + inverseB;
+
+    if (inverseSum == Scalar())
+        return;
+
+    auto positionA = Access::GetPosition(a), startA = Access::ToVector(this->SolveStart[contact.A]);
+    auto positionB = Access::GetPosition(b), startB = Access::ToVector(this->SolveStart[contact.B]);
+
+    // Overlap left after how far the bodies have moved apart along the normal since the solve began
+    Scalar moved = ((positionB.X - startB.X) - (positionA.X - startA.X)) * normalX + ((positionB.Y - startB.Y) - (positionA.Y - startA.Y)) * normalY;
+    Scalar depth = Access::ToScalar(contact.Depth) - moved;
+
+    Scalar correction = std::min((depth - Access::ToScalar(ContactSlop)) * Access::ToScalar(CorrectionRate), Access::ToScalar(MaxCorrection));
+
+    if (correction <= Scalar())
+        return;
+
+    correction = correction / inverseSum;
+
+    if (inverseA > Scalar())
+        Access::Move(a, -normalX * correction * inverseA, -normalY * correction * inverseA);
+
+    if (inverseB > Scalar())
+        Access::Move(b, normalX * correction * inverseB, normalY * correction * inverseB);
+}
+
+template<typename Scalar>
+void CacoEngine::PhysicsWorld::SolveContacts(std::vector<std::shared_ptr<RigidObject2D>>& objects, double deltaTime)
+{
+    using Access = SolverAccess<Scalar>;
+
+    double floor = this->GetFloorHeight();
+
+    this->Constraints.resize(this->Contacts.size());
+    this->SolveStart.resize(objects.size());
+    this->SolveVelocities.resize(objects.size());
+    this->FloorObjects.clear();
+    this->OnFloor.resize(objects.size(), 0);
+
+    for (int index : this->ActiveObjects)
+    {
+        RigidObject2D& object = *objects[index];
+
+        this->SolveStart[index] = object.Position;
+        this->SolveVelocities[index] = object.RigidBody.Velocity;
+
+        if (object.Position.Y >= floor)
+        {
+            this->FloorObjects.push_back(index);
+            this->OnFloor[index] = 1;
+        }
+    }
+
+    // Immovable ends aren't active, but the position passes read where they started
+    for (int x = 0; x < this->Contacts.size(); x++)
+    {
+        this->SolveStart[this->Contacts[x].A] = objects[this->Contacts[x].A]->Position;
+        this->SolveStart[this->Contacts[x].B] = objects[this->Contacts[x].B]->Position;
+    }
+
+    this->Pool->ParallelFor(this->Contacts.size(), 256, [&](int begin, int end, int thread)
+    {
+        for (int x = begin; x < end; x++)
+            this->PrepareContact<Scalar>(x, objects);
+    });
+
+    if (this->WarmStarting)
+        this->ForEachColor([&](int index) { this->WarmStartContact<Scalar>(index, objects); });
+
+    for (int pass = 0; pass < this->SolverIterations; pass++)
+    {
+        // The floor is an immovable, inelastic contact under every body resting on it
+        this->Pool->ParallelFor(this->FloorObjects.size(), 1024, [&](int begin, int end, int thread)
+        {
+            for (int x = begin; x < end; x++)
+                StopOnFloor<Scalar>(*objects[this->FloorObjects[x]]);
+        });
+
+        this->ForEachColor([&](int index) { this->SolveContact<Scalar>(index, objects); });
+    }
+
+    Scalar step = Access::ToScalar(deltaTime);
+
+    this->HoldPosition.resize(objects.size(), 0);
+
+    for (int index : this->ImpactObjects)
+        this->HoldPosition[index] = 1;
+
+    this->Pool->ParallelFor(this->ActiveObjects.size(), 1024, [&](int begin, int end, int thread)
+    {
+        for (int x = begin; x < end; x++)
+        {
+            int index = this->ActiveObjects[x];
+            RigidObject2D& object = *objects[index];
+
+            if (this->HoldPosition[index] || object.RigidBody.Velocity == this->SolveVelocities[index])
+                continue;
+
+            auto velocity = Access::GetVelocity(object);
+            auto start = Access::ToVector(this->SolveVelocities[index]);
+
+            Access::Move(object, (velocity.X - start.X) * step, (velocity.Y - start.Y) * step);
+        }
+    });
+
+    for (int index : this->ImpactObjects)
+        this->HoldPosition[index] = 0;
+
+    for (int pass = 0; pass < this->PositionIterations; pass++)
+        this->ForEachColor([&](int index) { this->CorrectContact<Scalar>(index, objects); });
+
+    for (int index : this->FloorObjects)
+        this->OnFloor[index] = 0;
+
+    this->Impulses.clear();
+
+    for (int x = 0; x < this->Contacts.size(); x++)
+        this->Impulses[this->GetPairKey(this->Contacts[x])] = { this->Constraints[x].NormalImpulse, this->Constraints[x].TangentImpulse };
+}
+
+void CacoEngine::PhysicsWorld::SolveContacts(std::vector<std::shared_ptr<RigidObject2D>>& objects, double deltaTime)
+{
+    this->ColorContacts(objects);
+
+    if (this->FixedPoint)
+        this->SolveContacts<Fixed>(objects, deltaTime);
+    else
+        this->SolveContacts<double>(objects, deltaTime);
+}
+
+bool CacoEngine::PhysicsWorld::IsRestingPair(RigidObject2D& a, RigidObject2D& b)
+{
+    bool restingA = a.RigidBody.Sleeping || a.RigidBody.Mass <= 0;
+    bool restingB = b.RigidBody.Sleeping || b.RigidBody.Mass <= 0;
+
+    return restingA && restingB && (a.RigidBody.Sleeping || b.RigidBody.Sleeping);
+}
+
+int CacoEngine::PhysicsWorld::FindIsland(int index)
+{
+    while (this->IslandParent[index] != index)
+    {
+        // Path halving
+        this->IslandParent[index] = this->IslandParent[this->IslandParent[index]];
+        index = this->IslandParent[index];
+    }
+
+    return index;
+}
+
+void CacoEngine::PhysicsWorld::UpdateSleeping(std::vector<std::shared_ptr<RigidObject2D>>& objects, double deltaTime)
+{
+    if (!this->AllowSleeping)
+    {
+        for (int x = 0; x < objects.size(); x++)
+            if (objects[x]->RigidBody.Sleeping)
+                objects[x]->RigidBody.Wake();
+
+        return;
+    }
+
+    double threshold = this->SleepVelocity * this->SleepVelocity;
+
+    // Bodies left out are asleep with nothing awake touching them, and stay that way
+    this->Pool->ParallelFor(this->ActiveObjects.size(), 1024, [&](int begin, int end, int thread)
+    {
+        for (int x = begin; x < end; x++)
+        {
+            RigidBody2D& body = objects[this->ActiveObjects[x]]->RigidBody;
+
+            double speed = body.Velocity.X * body.Velocity.X + body.Velocity.Y * body.Velocity.Y;
+
+            body.SleepTime = (speed > threshold) ? 0 : body.SleepTime + deltaTime;
+        }
+    });
+
+    this->IslandParent.resize(objects.size());
+    this->IslandRest.resize(objects.size());
+
+    for (int index : this->ActiveObjects)
+    {
+        this->IslandParent[index] = index;
+        this->IslandRest[index] = std::numeric_limits<double>::max();
+    }
+
+    // Immovable bodies don't carry motion across, so they never join islands
+    if (this->ResolveContacts)
+        for (int x = 0; x < this->Contacts.size(); x++)
+        {
+            int a = this->Contacts[x].A, b = this->Contacts[x].B;
+
+            if (objects[a]->RigidBody.Mass <= 0 || objects[b]->RigidBody.Mass <= 0)
+                continue;
+
+            int first = this->FindIsland(a), second = this->FindIsland(b);
+
+            // Lower index becomes the root, keeping the result independent of contact order
+            this->IslandParent[std::max(first, second)] = std::min(first, second);
+        }
+
+    for (int index : this->ActiveObjects)
+    {
+        double& rest = this->IslandRest[this->FindIsland(index)];
+
+        rest = std::min(rest, objects[index]->RigidBody.SleepTime);
+    }
+
+    for (int index : this->ActiveObjects)
+    {
+        RigidBody2D& body = objects[index]->RigidBody;
+
+        if (this->IslandRest[this->FindIsland(index)] >= this->TimeToSleep)
+        {
+            body.Sleeping = true;
+            body.Velocity = Vector2Df(0, 0);
+        }
+    }
+}
+
+void CacoEngine::PhysicsWorld::GatherActive(std::vector<std::shared_ptr<RigidObject2D>>& objects)
+{
+    this->ActiveObjects = this->BodyObjects;
+    this->IsActive.resize(objects.size(), 0);
+
+    for (int index : this->BodyObjects)
+        this->IsActive[index] = 1;
+
+    // Bodies woken by a contact this substep weren't integrated, but the solver moves them
+    for (int x = 0; x < this->Contacts.size(); x++)
+    {
+        int ends[2] = { this->Contacts[x].A, this->Contacts[x].B };
+
+        for (int y = 0; y < 2; y++)
+            if (!this->IsActive[ends[y]] && objects[ends[y]]->RigidBody.Mass > 0)
+            {
+                this->IsActive[ends[y]] = 1;
+                this->ActiveObjects.push_back(ends[y]);
+            }
+    }
+
+    for (int index : this->ActiveObjects)
+        this->IsActive[index] = 0;
+}
+
+int CacoEngine::PhysicsWorld::ChooseSubsteps(std::vector<std::shared_ptr<RigidObject2D>>& objects, double deltaTime)
+{
+    int fixed = std::max(this->Substeps, 1), limit = std::max(this->MaxSubsteps, fixed);
+    int count = fixed;
+
+    if (this->MaxSubstepTime > 0)
+        count = std::max(count, (int)std::min(std::ceil(deltaTime / this->MaxSubstepTime), (double)limit));
+
+    if (!this->AdaptiveSubsteps)
+        return count;
+
+    double fastest = 0;
+
+    for (int x = 0; x < objects.size(); x++)
+    {
+        RigidBody2D& body = objects[x]->RigidBody;
+
+        if (body.Mass > 0 && !body.Sleeping)
+            fastest = std::max(fastest, body.Velocity.X * body.Velocity.X + body.Velocity.Y * body.Velocity.Y);
+    }
+
+    // Enough substeps that the fastest body moves at most AdaptiveTravel in each
+    if (this->AdaptiveTravel > 0)
+        count = std::max(count, (int)std::min(std::ceil(std::sqrt(fastest) * deltaTime / this->AdaptiveTravel), (double)limit));
+
+    if (this->DeepestContact > this->AdaptiveDepth)
+        count *= 2;
+
+    return std::min(count, limit);
+}
+
+void CacoEngine::PhysicsWorld::Step(std::vector<std::shared_ptr<RigidObject2D>>& objects, double deltaTime)
+{
+    this->SubstepCount = this->ChooseSubsteps(objects, deltaTime);
+    this->SubstepEvents.clear();
+
+    double substep = deltaTime / this->SubstepCount;
+
+    for (int x = 0; x < this->SubstepCount; x++)
+    {
+        this->Substep(objects, substep);
+
+        // Stay events repeat in the last substep, begin and end events would be lost
+        if (this->ResolveContacts && x + 1 < this->SubstepCount)
+            for (int y = 0; y < this->Events.size(); y++)
+                if (this->Events[y].Type != ContactEventType::Stay)
+                    this->SubstepEvents.push_back(this->Events[y]);
+    }
+
+    if (!this->SubstepEvents.empty())
+        this->Events.insert(this->Events.begin(), this->SubstepEvents.begin(), this->SubstepEvents.end());
+
+    this->DeepestContact = 0;
+
+    if (this->ResolveContacts)
+        for (int x = 0; x < this->Contacts.size(); x++)
+            this->DeepestContact = std::max(this->DeepestContact, this->Contacts[x].Depth);
+}
+
+int CacoEngine::PhysicsWorld::GetSubstepCount()
+{
+    return this->SubstepCount;
+}
+
+void CacoEngine::PhysicsWorld::Substep(std::vector<std::shared_ptr<RigidObject2D>>& objects, double deltaTime)
+{
+    this->Integrate(objects, deltaTime);
+
+    this->SweepBodies(objects);
+
+    if (this->ResolveContacts)
+    {
+        this->UpdateContacts(objects);
+
+        // Anything touched by a moving body is woken before the solver pushes it
+        for (int x = 0; x < this->Contacts.size(); x++)
+        {
+            RigidBody2D& a = objects[this->Contacts[x].A]->RigidBody;
+            RigidBody2D& b = objects[this->Contacts[x].B]->RigidBody;
+
+            if (a.Sleeping && b.Mass > 0 && !b.Sleeping)
+                a.Wake();
+            else if (b.Sleeping && a.Mass > 0 && !a.Sleeping)
+                b.Wake();
+        }
+
+        this->GatherActive(objects);
+        this->SolveContacts(objects, deltaTime);
+
+        // The solver may have pushed bodies back through the floor
+        this->Pool->ParallelFor(this->ActiveObjects.size(), 1024, [&](int begin, int end, int thread)
+        {
+            for (int x = begin; x < end; x++)
+                this->ApplyFloor(*objects[this->ActiveObjects[x]]);
+        });
+    }
+    else
+        this->ActiveObjects = this->BodyObjects;
+
+    this->UpdateSleeping(objects, deltaTime);
+
+    // Objects may change before the next UpdatePairs
+    this->ProxiesSynced = false;
+}
+
+int CacoEngine::PhysicsWorld::GetAwakeCount()
+{
+    return this->AwakeCount;
+}
+
+const std::vector<CacoEngine::ContactEvent>& CacoEngine::PhysicsWorld::GetContactEvents()
+{
+    return this->Events;
+}
+
+const std::vector<CacoEngine::Contact>& CacoEngine::PhysicsWorld::GetContacts()
+{
+    return this->Contacts;
+}
+
+void CacoEngine::PhysicsWorld::QueryPoint(Vector2Df point, std::vector<RigidObject2D*>& objects, uint32_t mask)
+{
+    this->QueryResults.clear();
+    this->Phase->QueryRegion(AABB(point.X, point.Y, point.X, point.Y), this->QueryResults);
+
+    for (int x = 0; x < this->QueryResults.size(); x++)
+    {
+        RigidObject2D* object = this->ProxyOwners[this->QueryResults[x]];
+
+        if ((object->CollisionCategory & mask) && object->CollidesWith(point))
+            objects.push_back(object);
+    }
+}
+
+void CacoEngine::PhysicsWorld::QueryRegion(const AABB& region, std::vector<RigidObject2D*>& objects, uint32_t mask)
+{
+    this->QueryResults.clear();
+    this->Phase->QueryRegion(region, this->QueryResults);
+
+    for (int x = 0; x < this->QueryResults.size(); x++)
+        if (this->ProxyOwners[this->QueryResults[x]]->CollisionCategory & mask)
+            objects.push_back(this->ProxyOwners[this->QueryResults[x]]);
+}
+
+void CacoEngine::PhysicsWorld::QueryCircle(Vector2Df center, float radius, std::vector<RigidObject2D*>& objects, uint32_t mask)
+{
+    this->QueryResults.clear();
+    this->Phase->QueryRegion(AABB(center.X - radius, center.Y - radius, center.X + radius, center.Y + radius), this->QueryResults);
+
+    for (int x = 0; x < this->QueryResults.size(); x++)
+    {
+        RigidObject2D* object = this->ProxyOwners[this->QueryResults[x]];
+
+        if (!(object->CollisionCategory & mask))
+            continue;
+
+        double dx, dy, reach = radius;
+
+        if (RigidCircle* circle = dynamic_cast<RigidCircle*>(object))
+        {
+            dx = circle->Position.X - center.X;
+            dy = circle->Position.Y - center.Y;
+            reach += circle->GetRadius();
+        }
+        else
+        {
+            // Distance to the closest point of the bounds
+            AABB bounds = object->GetBounds();
+
+            dx = std::clamp((float)center.X, bounds.MinX, bounds.MaxX) - center.X;
+            dy = std::clamp((float)center.Y, bounds.MinY, bounds.MaxY) - center.Y;
+        }
+
+        if (dx * dx + dy * dy <= reach * reach)
+            objects.push_back(object);
+    }
+}
+
+bool CacoEngine::PhysicsWorld::RayCast(Vector2Df start, Vector2Df end, RaycastHit& hit, uint32_t mask)
+{
+    this->QueryResults.clear();
+    this->Phase->QueryRay(start, end, this->QueryResults);
+
+    hit = RaycastHit();
+
+    double dx = end.X - start.X, dy = end.Y - start.Y;
+
+    for (int x = 0; x < this->QueryResults.size(); x++)
+    {
+        RigidObject2D* object = this->ProxyOwners[this->QueryResults[x]];
+
+        if (!(object->CollisionCategory & mask))
+            continue;
+
+        double fraction;
+        Vector2Df normal;
+
+        if (RigidCircle* circle = dynamic_cast<RigidCircle*>(object))
+        {
+            // |start + t * d - center|^2 = r^2, nearest root
+            double fx = start.X - circle->Position.X, fy = start.Y - circle->Position.Y;
+            double a = dx * dx + dy * dy, b = 2 * (fx * dx + fy * dy), c = fx * fx + fy * fy - circle->GetRadius() * circle->GetRadius();
+
+            if (c <= 0)
+                fraction = 0;
+            else
+            {
+                double discriminant = b * b - 4 * a * c;
+
+                if (a == 0 || discriminant < 0)
+                    continue;
+
+                fraction = (-b - std::sqrt(discriminant)) / (2 * a);
+
+                if (fraction < 0 || fraction > 1)
+                    continue;
+            }
+
+            double px = start.X + dx * fraction - circle->Position.X, py = start.Y + dy * fraction - circle->Position.Y;
+            double length = std::sqrt(px * px + py * py);
+
+            normal = (length > 0) ? Vector2Df(px / length, py / length) : Vector2Df(-dx, -dy);
+        }
+        else
+        {
+            AABB bounds = object->GetBounds();
+
+            float entry;
+
+            if (!bounds.IntersectsSegment(start, end, &entry))
+                continue;
+
+            fraction = entry;
+
+            // The face hit is on the axis whose slab was entered last
+            double px = start.X + dx * fraction, py = start.Y + dy * fraction;
+
+            double left = std::fabs(px - bounds.MinX), right = std::fabs(px - bounds.MaxX);
+            double top = std::fabs(py - bounds.MinY), bottom = std::fabs(py - bounds.MaxY);
+            double closest = std::min(std::min(left, right), std::min(top, bottom));
+
+            if (closest == left)
+                normal = Vector2Df(-1, 0);
+            else if (closest == right)
+                normal = Vector2Df(1, 0);
+            else if (closest == top)
+                normal = Vector2Df(0, -1);
+            else
+                normal = Vector2Df(0, 1);
+        }
+
+        if (!hit.Object || fraction < hit.Fraction)
+        {
+            hit.Object = object;
+            hit.Fraction = fraction;
+            hit.Point = Vector2Df(start.X + dx * fraction, start.Y + dy * fraction);
+            hit.Normal = normal;
+        }
+    }
+
+    return hit.Object != nullptr;
+}
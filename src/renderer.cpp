@@ -1,30 +1,365 @@
 #include "renderer.hpp"
+#include "objects.hpp"
 #include <SDL_pixels.h>
 #include <SDL_render.h>
+#include <cmath>
+#include <algorithm>
+#include <string>
 
 CacoEngine::Renderer::Renderer(SDL_Window *window)
+    : Instance(nullptr), FrameStats(RenderStats()), StatsHistory(), StatsIndex(0), StatsCount(0), FrameNumber(0), LastTexture(nullptr), StatsDump(nullptr, fclose),
+      Transform(CameraTransform()), VisibleArea(SDL_FRect { 0, 0, 0, 0 }), HasCamera(false)
 {
     if (window)
-        this->Instance = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+        this->Instance = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
 }
 
-CacoEngine::Renderer::~Renderer() {}
-
 void CacoEngine::Renderer::Clear(CacoEngine::RGBA color)
 {
+    if (!(color == this->Color))
+        this->FrameStats.ColorChanges++;
+
     this->Color = color;
 
-    SDL_SetRenderDrawColor(this->Instance, this->Color.R, this->Color.G, this->Color.B, SDL_ALPHA_OPAQUE);
+    SDL_SetRenderDrawColor(this->Instance, this->Color.R, this->Color.G, this->Color.B, this->Color.A);
     SDL_RenderClear(this->Instance);
 }
 
 void CacoEngine::Renderer::SetColor(RGBA color)
 {
+    if (!(color == this->Color))
+        this->FrameStats.ColorChanges++;
+
     this->Color = color;
 
     SDL_SetRenderDrawColor(this->Instance, this->Color.R, this->Color.G, this->Color.B, SDL_ALPHA_OPAQUE);
 }
 
+void CacoEngine::Renderer::BatchLines(Object& object)
+{
+    std::vector<Vertex2Df>& vertices = object.ObjectMesh.Vertices;
+
+    Color32 color = RGBA(object.FillColor.R, object.FillColor.G, object.FillColor.B);
+
+    // SDL2 only exposes line strips, so every segment of the object's strip becomes
+    // a one pixel wide quad and all of them go out in a single geometry call
+    for (int x = 0; x + 1 < vertices.size(); x++)
+    {
+        // Endpoints go through the camera first so lines stay one pixel wide at any zoom
+        Point2Df start = this->Transform.Apply(vertices[x].Position);
+        Point2Df end = this->Transform.Apply(vertices[x + 1].Position);
+
+        float x0 = start.X + 0.5f, y0 = start.Y + 0.5f;
+        float x1 = end.X + 0.5f, y1 = end.Y + 0.5f;
+
+        float dx = x1 - x0, dy = y1 - y0;
+        float length = std::sqrt(dx * dx + dy * dy);
+
+        if (length > 0)
+        {
+            dx = (dx / length) * 0.5f;
+            dy = (dy / length) * 0.5f;
+        }
+        else
+            dx = 0.5f;
+
+        // Extend half a pixel past both endpoints so they are covered like SDL's inclusive lines
+        x0 -= dx; y0 -= dy;
+        x1 += dx; y1 += dy;
+
+        int base = this->LineBatch.size();
+
+        this->LineBatch.push_back(Vertex2Df(Point2Df(x0 - dy, y0 + dx), color, Point2Df()));
+        this->LineBatch.push_back(Vertex2Df(Point2Df(x0 + dy, y0 - dx), color, Point2Df()));
+        this->LineBatch.push_back(Vertex2Df(Point2Df(x1 + dy, y1 - dx), color, Point2Df()));
+        this->LineBatch.push_back(Vertex2Df(Point2Df(x1 - dy, y1 + dx), color, Point2Df()));
+
+        this->LineIndices.insert(this->LineIndices.end(), { base, base + 1, base + 2, base + 2, base + 3, base });
+    }
+
+    if (vertices.size() > 1)
+        this->FrameStats.BytesConverted += (vertices.size() - 1) * (4 * sizeof(Vertex2Df) + 6 * sizeof(int));
+}
+
+void CacoEngine::Renderer::BatchPoints(Object& object)
+{
+    std::vector<Vertex2Df>& vertices = object.ObjectMesh.Vertices;
+
+    uint32_t key = ((uint32_t)(uint8_t)object.FillColor.R << 16) | ((uint32_t)(uint8_t)object.FillColor.G << 8) | (uint8_t)object.FillColor.B;
+
+    std::vector<SDL_FPoint>& points = this->PointBatches[key];
+
+    int first = points.size();
+
+    for (int x = 0; x < vertices.size(); x++)
+        points.push_back(vertices[x].GetSDLPoint());
+
+    if (this->HasCamera)
+        TransformPoints(this->Transform, points.data() + first, vertices.size());
+
+    this->FrameStats.BytesConverted += vertices.size() * sizeof(SDL_FPoint);
+}
+
+void CacoEngine::Renderer::Flush()
+{
+    if (!this->LineIndices.empty())
+    {
+        this->DrawGeometry(nullptr, this->LineBatch.data(), this->LineBatch.size(),
+                           this->LineIndices.data(), this->LineIndices.size());
+
+        this->LineBatch.clear();
+        this->LineIndices.clear();
+    }
+
+    RGBA previous = this->Color;
+
+    bool drawn = false;
+
+    for (auto it = this->PointBatches.begin(); it != this->PointBatches.end(); it++)
+    {
+        if (it->second.empty())
+            continue;
+
+        this->SetColor(RGBA((it->first >> 16) & 0xFF, (it->first >> 8) & 0xFF, it->first & 0xFF));
+
+        SDL_RenderDrawPointsF(this->Instance, it->second.data(), it->second.size());
+        drawn = true;
+
+        this->FrameStats.DrawCalls++;
+        this->FrameStats.Vertices += it->second.size();
+
+        // Keeps capacity, so steady-state frames don't allocate
+        it->second.clear();
+    }
+
+    // Only a point batch changes the draw color
+    if (drawn)
+        this->SetColor(previous);
+}
+
+void CacoEngine::Renderer::DrawObject(Object& object)
+{
+    if (object.FillMode == RasterizeMode::WireFrame)
+        this->BatchLines(object);
+
+    else if (object.FillMode == RasterizeMode::Points)
+        this->BatchPoints(object);
+
+    else
+        this->DrawGeometry((object.FillMode == RasterizeMode::Texture) ? object.mTexture.GetInstance() : nullptr,
+                           object.ObjectMesh.Vertices.data(),
+                           object.ObjectMesh.Vertices.size());
+}
+
+void CacoEngine::Renderer::DrawGeometry(SDL_Texture* texture, const Vertex2Df* vertices, int count, const int* indices, int indexCount)
+{
+    if (count <= 0)
+        return;
+
+    // Vertices stay in world space, the camera is applied to a scratch copy of each batch
+    if (this->HasCamera)
+    {
+        if (this->TransformScratch.size() < count)
+            this->TransformScratch.resize(count);
+
+        TransformVertices(this->Transform, vertices, this->TransformScratch.data(), count);
+
+        vertices = this->TransformScratch.data();
+
+        this->FrameStats.BytesConverted += count * sizeof(Vertex2Df);
+    }
+
+    SDL_RenderGeometryRaw(this->Instance, texture,
+                          &vertices[0].Position.X, sizeof(Vertex2Df),
+                          reinterpret_cast<const SDL_Color*>(&vertices[0].Color), sizeof(Vertex2Df),
+                          &vertices[0].TextureCoordinates.X, sizeof(Vertex2Df),
+                          count,
+                          indices, indexCount, (indices) ? sizeof(int) : 0);
+
+    if (texture != this->LastTexture)
+    {
+        this->FrameStats.TextureSwitches++;
+        this->LastTexture = texture;
+    }
+
+    this->FrameStats.DrawCalls++;
+    this->FrameStats.Vertices += count;
+    this->FrameStats.Indices += indexCount;
+}
+
+void CacoEngine::Renderer::DrawTexture(SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect* destination)
+{
+    SDL_RenderCopy(this->Instance, texture, source, destination);
+
+    if (texture != this->LastTexture)
+    {
+        this->FrameStats.TextureSwitches++;
+        this->LastTexture = texture;
+    }
+
+    this->FrameStats.DrawCalls++;
+    this->FrameStats.Vertices += 4;
+}
+
+void CacoEngine::Renderer::SetCamera(const Camera* camera)
+{
+    // Queued lines and points were transformed by the previous camera and clipped to its viewport
+    this->Flush();
+
+    if (!camera)
+    {
+        SDL_RenderSetViewport(this->Instance, nullptr);
+
+        this->Transform = CameraTransform();
+        this->HasCamera = false;
+
+        return;
+    }
+
+    Vector2D output;
+
+    SDL_GetRendererOutputSize(this->Instance, &output.X, &output.Y);
+
+    SDL_Rect viewport = camera->GetViewportRect(output);
+
+    SDL_RenderSetViewport(this->Instance, &viewport);
+
+    this->Transform = camera->GetTransform(output);
+    this->VisibleArea = camera->GetVisibleArea(output);
+    this->HasCamera = !this->Transform.IsIdentity();
+}
+
+void CacoEngine::Renderer::SetTransform(const CameraTransform& transform, SDL_FRect visibleArea)
+{
+    this->Flush();
+
+    this->Transform = transform;
+    this->VisibleArea = visibleArea;
+    this->HasCamera = !this->Transform.IsIdentity();
+}
+
+const CacoEngine::CameraTransform& CacoEngine::Renderer::GetTransform()
+{
+    return this->Transform;
+}
+
+SDL_FRect CacoEngine::Renderer::GetVisibleArea()
+{
+    if (this->HasCamera)
+        return this->VisibleArea;
+
+    SDL_Rect viewport;
+
+    SDL_RenderGetViewport(this->Instance, &viewport);
+
+    return SDL_FRect { 0, 0, (float)viewport.w, (float)viewport.h };
+}
+
+CacoEngine::RenderStats& CacoEngine::Renderer::GetFrameStats()
+{
+    return this->FrameStats;
+}
+
+CacoEngine::RenderStats CacoEngine::Renderer::GetLastFrameStats()
+{
+    if (this->StatsCount == 0)
+        return RenderStats();
+
+    return this->StatsHistory[(this->StatsIndex + StatsWindow - 1) % StatsWindow];
+}
+
+CacoEngine::RenderStats CacoEngine::Renderer::GetAverageStats()
+{
+    RenderStats total = RenderStats();
+
+    if (this->StatsCount == 0)
+        return total;
+
+    for (int x = 0; x < this->StatsCount; x++)
+    {
+        RenderStats& frame = this->StatsHistory[x];
+
+        total.DrawCalls += frame.DrawCalls;
+        total.Vertices += frame.Vertices;
+        total.Indices += frame.Indices;
+        total.TextureSwitches += frame.TextureSwitches;
+        total.ColorChanges += frame.ColorChanges;
+        total.CulledObjects += frame.CulledObjects;
+        total.BytesConverted += frame.BytesConverted;
+    }
+
+    total.DrawCalls /= this->StatsCount;
+    total.Vertices /= this->StatsCount;
+    total.Indices /= this->StatsCount;
+    total.TextureSwitches /= this->StatsCount;
+    total.ColorChanges /= this->StatsCount;
+    total.CulledObjects /= this->StatsCount;
+    total.BytesConverted /= this->StatsCount;
+
+    return total;
+}
+
+CacoEngine::RenderStats CacoEngine::Renderer::GetPeakStats()
+{
+    RenderStats peak = RenderStats();
+
+    for (int x = 0; x < this->StatsCount; x++)
+    {
+        RenderStats& frame = this->StatsHistory[x];
+
+        peak.DrawCalls = std::max(peak.DrawCalls, frame.DrawCalls);
+        peak.Vertices = std::max(peak.Vertices, frame.Vertices);
+        peak.Indices = std::max(peak.Indices, frame.Indices);
+        peak.TextureSwitches = std::max(peak.TextureSwitches, frame.TextureSwitches);
+        peak.ColorChanges = std::max(peak.ColorChanges, frame.ColorChanges);
+        peak.CulledObjects = std::max(peak.CulledObjects, frame.CulledObjects);
+        peak.BytesConverted = std::max(peak.BytesConverted, frame.BytesConverted);
+    }
+
+    return peak;
+}
+
+void CacoEngine::Renderer::EndFrame()
+{
+    RenderStats& frame = this->FrameStats;
+
+    if (this->StatsDump)
+        fprintf(this->StatsDump.get(), "%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu\n",
+                (unsigned long long)this->FrameNumber,
+                (unsigned long long)frame.DrawCalls, (unsigned long long)frame.Vertices, (unsigned long long)frame.Indices,
+                (unsigned long long)frame.TextureSwitches, (unsigned long long)frame.ColorChanges,
+                (unsigned long long)frame.CulledObjects, (unsigned long long)frame.BytesConverted);
+
+    this->StatsHistory[this->StatsIndex] = frame;
+    this->StatsIndex = (this->StatsIndex + 1) % StatsWindow;
+    this->StatsCount = std::min(this->StatsCount + 1, StatsWindow);
+
+    this->FrameNumber++;
+    this->FrameStats = RenderStats();
+
+    // Texture state isn't tracked across frames
+    this->LastTexture = nullptr;
+}
+
+bool CacoEngine::Renderer::EnableStatsDump(std::string_view path)
+{
+    this->DisableStatsDump();
+
+    this->StatsDump.reset(fopen(std::string(path).c_str(), "w"));
+
+    if (!this->StatsDump)
+        return false;
+
+    fprintf(this->StatsDump.get(), "frame,draw_calls,vertices,indices,texture_switches,color_changes,culled_objects,bytes_converted\n");
+
+    return true;
+}
+
+void CacoEngine::Renderer::DisableStatsDump()
+{
+    this->StatsDump.reset();
+}
+
 SDL_Renderer* CacoEngine::Renderer::GetInstance()
 {
     return this->Instance;
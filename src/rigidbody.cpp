@@ -9,7 +9,22 @@ CacoEngine::RigidBody2D::RigidBody2D(CacoEngine::Vector2Df velocity, CacoEngine:
 void CacoEngine::RigidBody2D::AddForce(Vector2Df force)
 {
     this->Force += force;
-    this->UpdateAcceleration();
+    this->Wake();
+}
+
+void CacoEngine::RigidBody2D::AddImpulse(Vector2Df impulse)
+{
+    if (this->Mass <= 0)
+        return;
+
+    this->Velocity += impulse / this->Mass;
+    this->Wake();
+}
+
+void CacoEngine::RigidBody2D::Wake()
+{
+    this->Sleeping = false;
+    this->SleepTime = 0;
 }
 
 void CacoEngine::RigidBody2D::UpdateAcceleration()
@@ -1,6 +1,9 @@
 #include "rigidobject.hpp"
 #include "objects.hpp"
 #include "vertex.hpp"
+#include <algorithm>
+
+std::atomic<uint64_t> CacoEngine::RigidObject2D::NextPhysicsID = 1;
 
 CacoEngine::RigidObject2D::RigidObject2D() : Object()
 {
@@ -19,6 +22,8 @@ CacoEngine::RigidObject2D& CacoEngine::RigidObject2D::operator =(const CacoEngin
     this->FillColor = object.FillColor;
     this->FillMode = object.FillMode;
     this->RigidBody = object.RigidBody;
+    this->CollisionCategory = object.CollisionCategory;
+    this->CollisionMask = object.CollisionMask;
 
     return *this;
 }
@@ -27,14 +32,53 @@ CacoEngine::RigidObject2D::~RigidObject2D()
 {
 }
 
-bool CacoEngine::RigidObject2D::CollidesWith(CacoEngine::RigidObject2D object)
+uint64_t CacoEngine::RigidObject2D::GetPhysicsID() const
 {
-    return false;
+    return this->PhysicsID;
+}
+
+bool CacoEngine::RigidObject2D::CollidesWith(CacoEngine::RigidObject2D& object)
+{
+    Narrowphase narrowphase;
+
+    int first = this->AddShape(narrowphase);
+
+    return narrowphase.Test(first, object.AddShape(narrowphase));
 }
 
 bool CacoEngine::RigidObject2D::CollidesWith(CacoEngine::Vector2Df point)
 {
-    return false;
+    return this->GetBounds().Contains(point);
+}
+
+CacoEngine::AABB CacoEngine::RigidObject2D::GetBounds()
+{
+    std::vector<Vertex2Df>& vertices = this->ObjectMesh.Vertices;
+
+    if (vertices.empty())
+        return AABB(this->Position.X, this->Position.Y, this->Position.X, this->Position.Y);
+
+    AABB bounds(vertices[0].Position.X, vertices[0].Position.Y, vertices[0].Position.X, vertices[0].Position.Y);
+
+    for (int x = 1; x < vertices.size(); x++)
+    {
+        bounds.MinX = std::min(bounds.MinX, vertices[x].Position.X);
+        bounds.MinY = std::min(bounds.MinY, vertices[x].Position.Y);
+        bounds.MaxX = std::max(bounds.MaxX, vertices[x].Position.X);
+        bounds.MaxY = std::max(bounds.MaxY, vertices[x].Position.Y);
+    }
+
+    return bounds;
+}
+
+int CacoEngine::RigidObject2D::AddShape(Narrowphase& narrowphase)
+{
+    std::vector<Vertex2Df>& vertices = this->ObjectMesh.Vertices;
+
+    if (vertices.empty())
+        return narrowphase.AddBox(this->GetBounds());
+
+    return narrowphase.AddPolygon(&vertices[0].Position, vertices.size(), sizeof(Vertex2Df));
 }
 
 CacoEngine::RigidCircle::RigidCircle(CacoEngine::Vector2Df origin, double radius)
@@ -67,16 +111,21 @@ CacoEngine::RigidCircle::~RigidCircle() {}
 
 bool CacoEngine::RigidCircle::CollidesWith(Vector2Df point)
 {
-    std::cout << "CollidesWith(Vector2Df)\n";
-
-    double distance = this->Position.DistanceFrom(point);
+    return (this->Position.DistanceFrom(point) < this->GetRadius());
+}
 
-    std::cout << "Distance: " << distance << '\n';
 
+CacoEngine::AABB CacoEngine::RigidCircle::GetBounds()
+{
+    float radius = this->GetRadius();
 
-    return (distance < this->GetRadius());
+    return AABB(this->Position.X - radius, this->Position.Y - radius, this->Position.X + radius, this->Position.Y + radius);
 }
 
+int CacoEngine::RigidCircle::AddShape(Narrowphase& narrowphase)
+{
+    return narrowphase.AddCircle(this->Position, this->GetRadius());
+}
 
 void CacoEngine::RigidCircle::Sync()
 {
@@ -97,12 +146,7 @@ void CacoEngine::RigidCircle::SetRadius(double radius)
 
 bool CacoEngine::RigidCircle::CollidesWith(RigidCircle &circle)
 {
-    std::cout << "CenterDistance: " << (this->Position.DistanceFrom(circle.Position)) << std::endl; //  - (circle.GetRadius() + this->GetRadius()));
-
-    CacoEngine::Vector2Df center = this->mCircle.GetCenter(), center1 = circle.Position;
-
-
-    return (fabs((center.X - center1.X) * (center.X - center1.X) + (center.Y - center1.Y) * (center.Y - center1.Y)) <= (this->GetRadius() + circle.GetRadius() * (this->GetRadius() + circle.GetRadius()))); //  - (circle.GetRadius() + this->GetRadius())) <= 0);
+    return Narrowphase::TestCircles(this->Position, this->GetRadius(), circle.Position, circle.GetRadius());
 }
 
 // CacoEngine::Box2D::Box2D(CacoEngine::Vector2D dimensions, Vector2D position, RGBA color) : Rectangle(dimensions, position, color), RigidBody2D()
@@ -8,4 +8,9 @@ CacoEngine::Sprite::Sprite(CacoEngine::Texture texture, Vector2Df dimensions, Ve
     this->FillMode = RasterizeMode::Texture;
 }
 
+void CacoEngine::Sprite::SetRegion(TextureRegion region, bool flipX, bool flipY)
+{
+    this->ObjectMesh.SetQuadRegion(region, flipX, flipY);
+}
+
 CacoEngine::Sprite::~Sprite() {}
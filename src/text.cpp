@@ -0,0 +1,400 @@
+#include "text.hpp"
+#include <SDL_render.h>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <unordered_map>
+#include <charconv>
+
+CacoEngine::Glyph::Glyph() : Region(TextureRegion()), Size(Vector2D()), Offset(Vector2D()), Advance(0)
+{
+}
+
+CacoEngine::BitmapFont::BitmapFont(Texture atlas, int lineHeight) : Atlas(atlas), AtlasSize(Vector2D()), LineHeight(lineHeight)
+{
+    // A texture still loading would report the placeholder's size, load fonts with Finish first
+    if (atlas.GetState() == TextureState::Loading)
+        std::cout << "Font atlas is still loading, its glyphs can't be mapped\n";
+    else if (atlas.GetInstance())
+        SDL_QueryTexture(atlas.GetInstance(), nullptr, nullptr, &this->AtlasSize.X, &this->AtlasSize.Y);
+}
+
+CacoEngine::BitmapFont::~BitmapFont()
+{
+}
+
+CacoEngine::Glyph& CacoEngine::BitmapFont::GetGlyph(char character)
+{
+    Glyph& glyph = this->Glyphs[(uint8_t)character];
+
+    // Fall back to '?' for characters the font doesn't cover
+    if (glyph.Advance == 0 && this->Glyphs[(uint8_t)'?'].Advance != 0)
+        return this->Glyphs[(uint8_t)'?'];
+
+    return glyph;
+}
+
+void CacoEngine::BitmapFont::Layout(std::string_view text, Vector2Df position, RGBA color, float scale, std::vector<Vertex2Df>& vertices)
+{
+    float penX = position.X, penY = position.Y;
+
+    Color32 packed = color;
+
+    for (int x = 0; x < text.size(); x++)
+    {
+        if (text[x] == '\n')
+        {
+            penX = position.X;
+            penY += this->LineHeight * scale;
+
+            continue;
+        }
+
+        Glyph& glyph = this->GetGlyph(text[x]);
+
+        if (glyph.Size.X > 0 && glyph.Size.Y > 0)
+        {
+            float x0 = penX + glyph.Offset.X * scale, y0 = penY + glyph.Offset.Y * scale;
+            float x1 = x0 + glyph.Size.X * scale, y1 = y0 + glyph.Size.Y * scale;
+
+            const TextureRegion& uv = glyph.Region;
+
+            // Same two-triangle order as Rectangle
+            vertices.push_back(Vertex2Df(Point2Df(x0, y0), packed, Point2Df(uv.U0, uv.V0)));
+            vertices.push_back(Vertex2Df(Point2Df(x0, y1), packed, Point2Df(uv.U0, uv.V1)));
+            vertices.push_back(Vertex2Df(Point2Df(x1, y1), packed, Point2Df(uv.U1, uv.V1)));
+            vertices.push_back(Vertex2Df(Point2Df(x1, y1), packed, Point2Df(uv.U1, uv.V1)));
+            vertices.push_back(Vertex2Df(Point2Df(x1, y0), packed, Point2Df(uv.U1, uv.V0)));
+            vertices.push_back(Vertex2Df(Point2Df(x0, y0), packed, Point2Df(uv.U0, uv.V0)));
+        }
+
+        penX += glyph.Advance * scale;
+    }
+}
+
+CacoEngine::Vector2Df CacoEngine::BitmapFont::Measure(std::string_view text, float scale)
+{
+    float width = 0, lineWidth = 0;
+    int lines = 1;
+
+    for (int x = 0; x < text.size(); x++)
+    {
+        if (text[x] == '\n')
+        {
+            lines++;
+            lineWidth = 0;
+
+            continue;
+        }
+
+        lineWidth += this->GetGlyph(text[x]).Advance * scale;
+
+        if (lineWidth > width)
+            width = lineWidth;
+    }
+
+    return Vector2Df(width, lines * this->LineHeight * scale);
+}
+
+std::shared_ptr<CacoEngine::BitmapFont> CacoEngine::BitmapFont::LoadGrid(std::string_view path, Renderer& renderer, Vector2D cellSize, int firstCharacter, int count)
+{
+    Texture atlas = TextureManager::CreateTexture(path, renderer);
+
+    if (!atlas.mTexture)
+    {
+        std::cout << "Failed to load font atlas " << path << ": " << SDL_GetError() << '\n';
+        return nullptr;
+    }
+
+    std::shared_ptr<BitmapFont> font = std::make_shared<BitmapFont>(atlas, cellSize.Y);
+
+    int columns = (cellSize.X > 0) ? font->AtlasSize.X / cellSize.X : 0;
+
+    if (columns <= 0)
+        return font;
+
+    for (int x = 0; x < count && firstCharacter + x < 256; x++)
+    {
+        Glyph& glyph = font->Glyphs[firstCharacter + x];
+
+        Vector2D cell((x % columns) * cellSize.X, (x / columns) * cellSize.Y);
+
+        glyph.Region = TextureRegion((float)cell.X / font->AtlasSize.X, (float)cell.Y / font->AtlasSize.Y,
+                                     (float)(cell.X + cellSize.X) / font->AtlasSize.X, (float)(cell.Y + cellSize.Y) / font->AtlasSize.Y);
+        glyph.Size = cellSize;
+        glyph.Advance = cellSize.X;
+    }
+
+    return font;
+}
+
+// Parses the key=value pairs of one BMFont descriptor line
+static std::unordered_map<std::string, std::string> ParseBMFontLine(std::istringstream& stream)
+{
+    std::unordered_map<std::string, std::string> values;
+    std::string token;
+
+    while (stream >> token)
+    {
+        size_t split = token.find('=');
+
+        if (split == std::string::npos)
+            continue;
+
+        std::string value = token.substr(split + 1);
+
+        // Quoted values (file names) may contain spaces
+        if (!value.empty() && value[0] == '"')
+        {
+            while (value.size() < 2 || value.back() != '"')
+            {
+                std::string rest;
+
+                if (!(stream >> rest))
+                    break;
+
+                value += ' ' + rest;
+            }
+
+            value = value.substr(1, value.size() - ((value.back() == '"') ? 2 : 1));
+        }
+
+        values[token.substr(0, split)] = value;
+    }
+
+    return values;
+}
+
+// Reads an integer value of a parsed line, false when the key is missing or the value isn't a whole number
+static bool ReadBMFontValue(const std::unordered_map<std::string, std::string>& values, const std::string& key, int& result)
+{
+    auto it = values.find(key);
+
+    if (it == values.end())
+        return false;
+
+    const std::string& value = it->second;
+
+    auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+
+    return error == std::errc() && end == value.data() + value.size();
+}
+
+// One validated "char" line, in atlas pixels
+struct BMFontCharacter
+{
+    int Id, X, Y, Width, Height, OffsetX, OffsetY, Advance;
+};
+
+std::shared_ptr<CacoEngine::BitmapFont> CacoEngine::BitmapFont::LoadBMFont(std::string_view path, Renderer& renderer)
+{
+    std::ifstream file = std::ifstream(std::string(path));
+
+    if (!file.is_open())
+    {
+        std::cout << "Failed to open font descriptor " << path << '\n';
+        return nullptr;
+    }
+
+    std::string directory = std::string(path.substr(0, path.find_last_of("/\\") + 1));
+    std::string line;
+    std::string page;
+
+    int lineHeight = 0;
+
+    std::vector<BMFontCharacter> characters;
+
+    // The whole descriptor is validated before the atlas is loaded, so a malformed one costs no texture
+    while (std::getline(file, line))
+    {
+        std::istringstream stream = std::istringstream(line);
+        std::string tag;
+
+        stream >> tag;
+
+        std::unordered_map<std::string, std::string> values = ParseBMFontLine(stream);
+
+        if (tag == "common" && values.contains("lineHeight"))
+        {
+            if (!ReadBMFontValue(values, "lineHeight", lineHeight))
+            {
+                std::cout << "Malformed line height in font descriptor " << path << '\n';
+                return nullptr;
+            }
+        }
+
+        else if (tag == "page" && values.contains("file") && page.empty())
+            page = values.at("file");
+
+        else if (tag == "char")
+        {
+            BMFontCharacter character;
+
+            if (!ReadBMFontValue(values, "id", character.Id) || !ReadBMFontValue(values, "x", character.X) ||
+                !ReadBMFontValue(values, "y", character.Y) || !ReadBMFontValue(values, "width", character.Width) ||
+                !ReadBMFontValue(values, "height", character.Height) || !ReadBMFontValue(values, "xoffset", character.OffsetX) ||
+                !ReadBMFontValue(values, "yoffset", character.OffsetY) || !ReadBMFontValue(values, "xadvance", character.Advance))
+            {
+                std::cout << "Malformed character in font descriptor " << path << '\n';
+                return nullptr;
+            }
+
+            characters.push_back(character);
+        }
+    }
+
+    if (page.empty())
+    {
+        std::cout << "Font descriptor " << path << " names no page\n";
+        return nullptr;
+    }
+
+    Texture atlas = TextureManager::CreateTexture(directory + page, renderer);
+
+    if (!atlas.mTexture)
+    {
+        std::cout << "Failed to load font page " << page << ": " << SDL_GetError() << '\n';
+        return nullptr;
+    }
+
+    std::shared_ptr<BitmapFont> font = std::make_shared<BitmapFont>(atlas, lineHeight);
+
+    if (font->AtlasSize.X <= 0 || font->AtlasSize.Y <= 0)
+        return nullptr;
+
+    for (int x = 0; x < characters.size(); x++)
+    {
+        const BMFontCharacter& character = characters[x];
+
+        if (character.Id < 0 || character.Id > 255)
+            continue;
+
+        Glyph& glyph = font->Glyphs[character.Id];
+
+        int u = character.X, v = character.Y;
+
+        glyph.Size = Vector2D(character.Width, character.Height);
+        glyph.Offset = Vector2D(character.OffsetX, character.OffsetY);
+        glyph.Advance = character.Advance;
+        glyph.Region = TextureRegion((float)u / font->AtlasSize.X, (float)v / font->AtlasSize.Y,
+                                     (float)(u + glyph.Size.X) / font->AtlasSize.X, (float)(v + glyph.Size.Y) / font->AtlasSize.Y);
+    }
+
+    return font;
+}
+
+CacoEngine::TextBatch::TextBatch(std::shared_ptr<BitmapFont> font) : Drawable(), Font(font), Dirty(true)
+{
+}
+
+CacoEngine::TextBatch::~TextBatch()
+{
+}
+
+int CacoEngine::TextBatch::AddText(std::string_view text, Vector2Df position, RGBA color, float scale)
+{
+    this->Entries.push_back(TextEntry { std::string(text), position, color, scale, true });
+    this->EntryVertices.emplace_back();
+    this->EntryDirty.push_back(1);
+    this->Dirty = true;
+
+    return this->Entries.size() - 1;
+}
+
+void CacoEngine::TextBatch::SetText(int entry, std::string_view text)
+{
+    if (this->Entries[entry].Content == text)
+        return;
+
+    // assign() reuses the string's capacity
+    this->Entries[entry].Content.assign(text);
+    this->MarkDirty(entry);
+}
+
+void CacoEngine::TextBatch::SetPosition(int entry, Vector2Df position)
+{
+    if (this->Entries[entry].Position == position)
+        return;
+
+    this->Entries[entry].Position = position;
+    this->MarkDirty(entry);
+}
+
+void CacoEngine::TextBatch::SetColor(int entry, RGBA color)
+{
+    if (this->Entries[entry].Color == color)
+        return;
+
+    this->Entries[entry].Color = color;
+    this->MarkDirty(entry);
+}
+
+void CacoEngine::TextBatch::SetVisible(int entry, bool visible)
+{
+    if (this->Entries[entry].Visible == visible)
+        return;
+
+    // Its cached quads are still valid, only the joined buffer changes
+    this->Entries[entry].Visible = visible;
+    this->Dirty = true;
+}
+
+CacoEngine::TextEntry& CacoEngine::TextBatch::GetEntry(int entry)
+{
+    this->MarkDirty(entry);
+
+    return this->Entries[entry];
+}
+
+void CacoEngine::TextBatch::Clear()
+{
+    this->Entries.clear();
+    this->EntryVertices.clear();
+    this->EntryDirty.clear();
+    this->Dirty = true;
+}
+
+void CacoEngine::TextBatch::MarkDirty(int entry)
+{
+    this->EntryDirty[entry] = 1;
+    this->Dirty = true;
+}
+
+void CacoEngine::TextBatch::Rebuild()
+{
+    // clear() keeps capacity, so steady-state relayouts don't allocate
+    this->Vertices.clear();
+
+    for (int x = 0; x < this->Entries.size(); x++)
+    {
+        TextEntry& entry = this->Entries[x];
+
+        if (this->EntryDirty[x])
+        {
+            this->EntryVertices[x].clear();
+            this->Font->Layout(entry.Content, entry.Position, entry.Color, entry.Scale, this->EntryVertices[x]);
+
+            this->EntryDirty[x] = 0;
+        }
+
+        if (entry.Visible)
+            this->Vertices.insert(this->Vertices.end(), this->EntryVertices[x].begin(), this->EntryVertices[x].end());
+    }
+
+    this->Dirty = false;
+}
+
+void CacoEngine::TextBatch::Draw(Renderer& renderer)
+{
+    if (!this->Font)
+        return;
+
+    if (this->Dirty)
+    {
+        this->Rebuild();
+
+        renderer.GetFrameStats().BytesConverted += this->Vertices.size() * sizeof(Vertex2Df);
+    }
+
+    renderer.DrawGeometry(this->Font->Atlas.GetInstance(), this->Vertices.data(), this->Vertices.size());
+}
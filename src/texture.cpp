@@ -16,12 +16,31 @@ CacoEngine::Texture &CacoEngine::Texture::operator=(const Texture &texture)
 {
     this->ID = texture.ID;
     this->mTexture = texture.mTexture;
+    this->Slot = texture.Slot;
 
     return *this;
 }
 
+SDL_Texture* CacoEngine::Texture::GetInstance() const
+{
+    return this->Slot ? this->Slot->Instance : this->mTexture;
+}
+
+CacoEngine::TextureState CacoEngine::Texture::GetState() const
+{
+    return this->Slot ? this->Slot->State.load() : TextureState::Ready;
+}
+
 CacoEngine::Texture::~Texture()
 {
 }
 
+CacoEngine::TextureSlot::TextureSlot(SDL_Texture* instance) : Instance(instance), State(TextureState::Loading)
+{
+}
+
+CacoEngine::TextureRegion::TextureRegion(float u0, float v0, float u1, float v1) : U0(u0), V0(v0), U1(u1), V1(v1)
+{
+}
+
 std::vector<CacoEngine::Texture> CacoEngine::TextureManager::Textures = std::vector<CacoEngine::Texture>();
@@ -0,0 +1,249 @@
+#include "textureloader.hpp"
+#include <SDL_image.h>
+#include <SDL_render.h>
+#include <SDL_surface.h>
+#include <SDL_timer.h>
+#include <algorithm>
+#include <iostream>
+
+CacoEngine::TextureLoader::TextureLoader() : Stopping(false), Pending(0), ThreadCount(0), Placeholder(nullptr), UploadBudget(2)
+{
+}
+
+CacoEngine::TextureLoader::~TextureLoader()
+{
+    this->Stop();
+}
+
+void CacoEngine::TextureLoader::SetThreadCount(int threads)
+{
+    this->ThreadCount = std::max(threads, 0);
+}
+
+CacoEngine::Texture CacoEngine::TextureLoader::Load(std::string_view path, Renderer& renderer)
+{
+    if (!this->Placeholder)
+    {
+        uint32_t clear = 0;
+
+        this->Placeholder = SDL_CreateTexture(renderer.GetInstance(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 1, 1);
+
+        if (this->Placeholder)
+        {
+            SDL_UpdateTexture(this->Placeholder, nullptr, &clear, sizeof(clear));
+            SDL_SetTextureBlendMode(this->Placeholder, SDL_BLENDMODE_BLEND);
+        }
+    }
+
+    Texture texture = Texture(TextureManager::Textures.size(), this->Placeholder);
+
+    texture.Slot = std::make_shared<TextureSlot>(this->Placeholder);
+
+    {
+        std::lock_guard<std::mutex> guard(this->Lock);
+
+        // Workers start with the first load, so engines that never load asynchronously pay nothing
+        if (this->Workers.empty())
+        {
+            int threads = this->ThreadCount;
+
+            if (threads <= 0)
+                threads = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+
+            this->Stopping = false;
+
+            for (int x = 0; x < threads; x++)
+                this->Workers.emplace_back(&TextureLoader::WorkerLoop, this);
+        }
+
+        this->Requests.push_back({ std::string(path), texture.Slot });
+        this->Pending++;
+    }
+
+    this->Signal.notify_one();
+
+    return texture;
+}
+
+void CacoEngine::TextureLoader::WorkerLoop()
+{
+    while (true)
+    {
+        LoadRequest request;
+
+        {
+            std::unique_lock<std::mutex> guard(this->Lock);
+
+            this->Signal.wait(guard, [this] { return this->Stopping || !this->Requests.empty(); });
+
+            if (this->Stopping)
+                return;
+
+            request = std::move(this->Requests.front());
+            this->Requests.pop_front();
+        }
+
+        SDL_Surface* image = IMG_Load(request.Path.c_str());
+
+        // Converting here leaves the render thread a plain copy into the texture
+        if (image && image->format->format != SDL_PIXELFORMAT_ARGB8888)
+        {
+            SDL_Surface* converted = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_ARGB8888, 0);
+
+            SDL_FreeSurface(image);
+
+            image = converted;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(this->Lock);
+
+            if (image)
+                this->Decoded.push_back({ image, request.Slot });
+            else
+            {
+                std::cout << "Failed to load texture " << request.Path << ": " << IMG_GetError() << '\n';
+
+                request.Slot->State = TextureState::Failed;
+                this->FailedSlots.push_back(request.Slot);
+                this->Pending--;
+            }
+        }
+
+        this->DecodeSignal.notify_all();
+    }
+}
+
+void CacoEngine::TextureLoader::UploadImage(Renderer& renderer, DecodedImage& decoded)
+{
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer.GetInstance(), decoded.Image);
+
+    SDL_FreeSurface(decoded.Image);
+
+    if (texture)
+    {
+        decoded.Slot->Instance = texture;
+        decoded.Slot->State = TextureState::Ready;
+    }
+    else
+    {
+        std::cout << "Failed to upload texture: " << SDL_GetError() << '\n';
+
+        decoded.Slot->State = TextureState::Failed;
+    }
+
+    std::lock_guard<std::mutex> guard(this->Lock);
+
+    if (!texture)
+        this->FailedSlots.push_back(decoded.Slot);
+
+    this->Pending--;
+}
+
+int CacoEngine::TextureLoader::Upload(Renderer& renderer)
+{
+    uint64_t start = SDL_GetPerformanceCounter();
+    uint64_t budget = (uint64_t)(this->UploadBudget * SDL_GetPerformanceFrequency() / 1000.0);
+
+    int uploaded = 0;
+
+    while (true)
+    {
+        DecodedImage decoded;
+
+        {
+            std::lock_guard<std::mutex> guard(this->Lock);
+
+            if (this->Decoded.empty())
+                break;
+
+            decoded = std::move(this->Decoded.front());
+            this->Decoded.pop_front();
+        }
+
+        this->UploadImage(renderer, decoded);
+
+        uploaded++;
+
+        if (SDL_GetPerformanceCounter() - start >= budget)
+            break;
+    }
+
+    return uploaded;
+}
+
+void CacoEngine::TextureLoader::Finish(Renderer& renderer)
+{
+    while (true)
+    {
+        DecodedImage decoded;
+
+        {
+            std::unique_lock<std::mutex> guard(this->Lock);
+
+            this->DecodeSignal.wait(guard, [this] { return this->Pending == 0 || !this->Decoded.empty(); });
+
+            if (this->Decoded.empty())
+                return;
+
+            decoded = std::move(this->Decoded.front());
+            this->Decoded.pop_front();
+        }
+
+        this->UploadImage(renderer, decoded);
+    }
+}
+
+int CacoEngine::TextureLoader::GetPendingCount()
+{
+    std::lock_guard<std::mutex> guard(this->Lock);
+
+    return this->Pending;
+}
+
+void CacoEngine::TextureLoader::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(this->Lock);
+
+        this->Stopping = true;
+    }
+
+    this->Signal.notify_all();
+
+    for (int x = 0; x < this->Workers.size(); x++)
+        if (this->Workers[x].joinable())
+            this->Workers[x].join();
+
+    this->Workers.clear();
+
+    for (int x = 0; x < this->Requests.size(); x++)
+    {
+        this->Requests[x].Slot->State = TextureState::Failed;
+        this->FailedSlots.push_back(this->Requests[x].Slot);
+    }
+
+    for (int x = 0; x < this->Decoded.size(); x++)
+    {
+        SDL_FreeSurface(this->Decoded[x].Image);
+
+        this->Decoded[x].Slot->State = TextureState::Failed;
+        this->FailedSlots.push_back(this->Decoded[x].Slot);
+    }
+
+    this->Requests.clear();
+    this->Decoded.clear();
+    this->Pending = 0;
+
+    if (this->Placeholder)
+    {
+        for (int x = 0; x < this->FailedSlots.size(); x++)
+            if (std::shared_ptr<TextureSlot> slot = this->FailedSlots[x].lock(); slot && slot->Instance == this->Placeholder)
+                slot->Instance = nullptr;
+
+        SDL_DestroyTexture(this->Placeholder);
+        this->Placeholder = nullptr;
+    }
+
+    this->FailedSlots.clear();
+}
@@ -0,0 +1,106 @@
+#include "threadpool.hpp"
+#include <algorithm>
+
+CacoEngine::ThreadPool::ThreadPool(int threads) : Job(nullptr), Count(0), ChunkSize(1), ChunkCount(0), NextChunk(0), Busy(0), Generation(0), Stopping(false)
+{
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int x = 1; x < threads; x++)
+        this->Workers.emplace_back(&ThreadPool::WorkerLoop, this, x);
+}
+
+CacoEngine::ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(this->Lock);
+        this->Stopping = true;
+    }
+
+    this->WorkReady.notify_all();
+
+    for (std::thread& worker : this->Workers)
+        worker.join();
+}
+
+int CacoEngine::ThreadPool::GetThreadCount()
+{
+    return this->Workers.size() + 1;
+}
+
+void CacoEngine::ThreadPool::RunChunks(int thread)
+{
+    for (int chunk = this->NextChunk++; chunk < this->ChunkCount; chunk = this->NextChunk++)
+    {
+        int begin = chunk * this->ChunkSize;
+
+        (*this->Job)(begin, std::min(begin + this->ChunkSize, this->Count), thread);
+    }
+}
+
+void CacoEngine::ThreadPool::WorkerLoop(int thread)
+{
+    uint64_t seen = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> guard(this->Lock);
+
+            this->WorkReady.wait(guard, [&]() { return this->Stopping || this->Generation != seen; });
+
+            if (this->Stopping)
+                return;
+
+            seen = this->Generation;
+        }
+
+        this->RunChunks(thread);
+
+        {
+            std::lock_guard<std::mutex> guard(this->Lock);
+
+            if (--this->Busy == 0)
+                this->WorkDone.notify_one();
+        }
+    }
+}
+
+void CacoEngine::ThreadPool::ParallelFor(int count, int chunkSize, const std::function<void(int, int, int)>& job)
+{
+    if (count <= 0)
+        return;
+
+    chunkSize = std::max(chunkSize, 1);
+
+    if (this->Workers.empty() || count <= chunkSize)
+    {
+        for (int begin = 0; begin < count; begin += chunkSize)
+            job(begin, std::min(begin + chunkSize, count), 0);
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(this->Lock);
+
+        this->Job = &job;
+        this->Count = count;
+        this->ChunkSize = chunkSize;
+        this->ChunkCount = (count + chunkSize - 1) / chunkSize;
+        this->NextChunk = 0;
+        this->Busy = this->Workers.size();
+        this->Generation++;
+    }
+
+    this->WorkReady.notify_all();
+
+    this->RunChunks(0);
+
+    // Workers may still be inside their last chunk
+    std::unique_lock<std::mutex> guard(this->Lock);
+
+    this->WorkDone.wait(guard, [&]() { return this->Busy == 0; });
+
+    this->Job = nullptr;
+}
@@ -0,0 +1,178 @@
+#include "tilemap.hpp"
+#include <SDL_render.h>
+#include <algorithm>
+#include <cmath>
+
+CacoEngine::Tilemap::Tilemap(Vector2D dimensions, Vector2Df tileSize, std::shared_ptr<SpriteSheet> tileset, int chunkSize)
+    : Drawable(), Dimensions(dimensions), ChunkSize((chunkSize > 0) ? std::min(chunkSize, 255) : 32), Tileset(tileset), Position(Vector2Df()), TileSize(tileSize), Gap(0)
+{
+    this->Tiles = std::vector<uint16_t>(this->Dimensions.X * this->Dimensions.Y, EmptyTile);
+
+    this->ChunkCount = Vector2D((this->Dimensions.X + this->ChunkSize - 1) / this->ChunkSize,
+                                (this->Dimensions.Y + this->ChunkSize - 1) / this->ChunkSize);
+
+    this->Chunks = std::vector<TileChunk>(this->ChunkCount.X * this->ChunkCount.Y);
+
+    for (int x = 0; x < this->Chunks.size(); x++)
+    {
+        this->Chunks[x].Quads = std::vector<uint16_t>(this->ChunkSize * this->ChunkSize, NoQuad);
+        this->Chunks[x].Dirty = false;
+    }
+}
+
+CacoEngine::Tilemap::~Tilemap()
+{
+}
+
+CacoEngine::TileChunk& CacoEngine::Tilemap::GetChunk(int chunkX, int chunkY)
+{
+    return this->Chunks[chunkY * this->ChunkCount.X + chunkX];
+}
+
+void CacoEngine::Tilemap::WriteQuad(Vertex2Df* quad, int x, int y, uint16_t tile)
+{
+    float x0 = this->Position.X + x * this->TileSize.X, y0 = this->Position.Y + y * this->TileSize.Y;
+    float x1 = x0 + this->TileSize.X - this->Gap, y1 = y0 + this->TileSize.Y - this->Gap;
+
+    TextureRegion uv = (this->Tileset && tile - 1 < this->Tileset->Frames.size()) ? this->Tileset->Frames[tile - 1] : TextureRegion();
+
+    Color32 color = (tile < this->Palette.size()) ? this->Palette[tile] : Colors[(int)Color::White];
+
+    // Same two-triangle order as Rectangle
+    quad[0] = Vertex2Df(Point2Df(x0, y0), color, Point2Df(uv.U0, uv.V0));
+    quad[1] = Vertex2Df(Point2Df(x0, y1), color, Point2Df(uv.U0, uv.V1));
+    quad[2] = Vertex2Df(Point2Df(x1, y1), color, Point2Df(uv.U1, uv.V1));
+    quad[3] = Vertex2Df(Point2Df(x1, y1), color, Point2Df(uv.U1, uv.V1));
+    quad[4] = Vertex2Df(Point2Df(x1, y0), color, Point2Df(uv.U1, uv.V0));
+    quad[5] = Vertex2Df(Point2Df(x0, y0), color, Point2Df(uv.U0, uv.V0));
+}
+
+void CacoEngine::Tilemap::RebuildChunk(int chunkX, int chunkY)
+{
+    TileChunk& chunk = this->GetChunk(chunkX, chunkY);
+
+    int startX = chunkX * this->ChunkSize, startY = chunkY * this->ChunkSize;
+    int endX = std::min(startX + this->ChunkSize, this->Dimensions.X), endY = std::min(startY + this->ChunkSize, this->Dimensions.Y);
+
+    int count = 0;
+
+    for (int y = startY; y < endY; y++)
+        for (int x = startX; x < endX; x++)
+            if (this->Tiles[y * this->Dimensions.X + x] != EmptyTile)
+                count++;
+
+    chunk.Vertices.resize(count * 6);
+    std::fill(chunk.Quads.begin(), chunk.Quads.end(), NoQuad);
+
+    int quad = 0;
+
+    for (int y = startY; y < endY; y++)
+        for (int x = startX; x < endX; x++)
+        {
+            uint16_t tile = this->Tiles[y * this->Dimensions.X + x];
+
+            if (tile == EmptyTile)
+                continue;
+
+            this->WriteQuad(&chunk.Vertices[quad * 6], x, y, tile);
+
+            chunk.Quads[(y - startY) * this->ChunkSize + (x - startX)] = quad++;
+        }
+
+    chunk.Dirty = false;
+}
+
+void CacoEngine::Tilemap::SetTile(int x, int y, uint16_t tile)
+{
+    if (x < 0 || y < 0 || x >= this->Dimensions.X || y >= this->Dimensions.Y)
+        return;
+
+    uint16_t& current = this->Tiles[y * this->Dimensions.X + x];
+
+    if (current == tile)
+        return;
+
+    current = tile;
+
+    TileChunk& chunk = this->GetChunk(x / this->ChunkSize, y / this->ChunkSize);
+
+    if (chunk.Dirty)
+        return;
+
+    uint16_t quad = chunk.Quads[(y % this->ChunkSize) * this->ChunkSize + (x % this->ChunkSize)];
+
+    // Non-empty to non-empty only changes UVs and color, patch the existing quad
+    if (quad != NoQuad && tile != EmptyTile)
+        this->WriteQuad(&chunk.Vertices[quad * 6], x, y, tile);
+    else
+        chunk.Dirty = true;
+}
+
+uint16_t CacoEngine::Tilemap::GetTile(int x, int y)
+{
+    if (x < 0 || y < 0 || x >= this->Dimensions.X || y >= this->Dimensions.Y)
+        return EmptyTile;
+
+    return this->Tiles[y * this->Dimensions.X + x];
+}
+
+void CacoEngine::Tilemap::Fill(uint16_t tile)
+{
+    std::fill(this->Tiles.begin(), this->Tiles.end(), tile);
+
+    this->Invalidate();
+}
+
+void CacoEngine::Tilemap::Invalidate()
+{
+    for (int x = 0; x < this->Chunks.size(); x++)
+        this->Chunks[x].Dirty = true;
+}
+
+CacoEngine::Vector2D CacoEngine::Tilemap::WorldToTile(Vector2Df position)
+{
+    return Vector2D((int)std::floor((position.X - this->Position.X) / this->TileSize.X),
+                    (int)std::floor((position.Y - this->Position.Y) / this->TileSize.Y));
+}
+
+CacoEngine::Vector2D CacoEngine::Tilemap::GetDimensions()
+{
+    return this->Dimensions;
+}
+
+void CacoEngine::Tilemap::Draw(Renderer& renderer)
+{
+    if (this->TileSize.X <= 0 || this->TileSize.Y <= 0)
+        return;
+
+    SDL_FRect area = renderer.GetVisibleArea();
+
+    float chunkWidth = this->ChunkSize * this->TileSize.X, chunkHeight = this->ChunkSize * this->TileSize.Y;
+
+    // Range of chunks overlapping the visible part of the world
+    int firstX = std::max(0, (int)std::floor((area.x - this->Position.X) / chunkWidth));
+    int firstY = std::max(0, (int)std::floor((area.y - this->Position.Y) / chunkHeight));
+    int lastX = std::min(this->ChunkCount.X - 1, (int)std::floor((area.x + area.w - this->Position.X) / chunkWidth));
+    int lastY = std::min(this->ChunkCount.Y - 1, (int)std::floor((area.y + area.h - this->Position.Y) / chunkHeight));
+
+    SDL_Texture* texture = (this->Tileset) ? this->Tileset->SheetTexture.GetInstance() : nullptr;
+
+    int visible = (lastX >= firstX && lastY >= firstY) ? (lastX - firstX + 1) * (lastY - firstY + 1) : 0;
+
+    renderer.GetFrameStats().CulledObjects += this->Chunks.size() - visible;
+
+    for (int y = firstY; y <= lastY; y++)
+        for (int x = firstX; x <= lastX; x++)
+        {
+            TileChunk& chunk = this->GetChunk(x, y);
+
+            if (chunk.Dirty)
+            {
+                this->RebuildChunk(x, y);
+
+                renderer.GetFrameStats().BytesConverted += chunk.Vertices.size() * sizeof(Vertex2Df);
+            }
+
+            renderer.DrawGeometry(texture, chunk.Vertices.data(), chunk.Vertices.size());
+        }
+}
@@ -12,8 +12,9 @@ CacoEngine::RGBA::RGBA(int r, int g, int b, int a) : R(r), G(g), B(b), A(a)
 {
 }
 
-CacoEngine::RGBA CacoEngine::Colors[5] = {RGBA(255, 0, 0), RGBA(0, 255, 0),
-                                         RGBA(0, 0, 255), RGBA(255, 255, 255),
+// Same order as the Color enum
+CacoEngine::RGBA CacoEngine::Colors[5] = {RGBA(255, 0, 0), RGBA(0, 0, 255),
+                                         RGBA(0, 255, 0), RGBA(255, 255, 255),
                                          RGBA(0, 0, 0)};
 
 CacoEngine::Vector2D CacoEngine::Vector2D::operator +(Vector2D rhs)
@@ -146,6 +147,61 @@ CacoEngine::Vertex2Df::Vertex2Df(Vector2Df position, RGBA color, Vector2Df textu
 {
 }
 
+CacoEngine::Vertex2Df::Vertex2Df(Point2Df position, Color32 color, Point2Df textureCoordinates) : Position(position), Color(color), TextureCoordinates(textureCoordinates)
+{
+}
+
+CacoEngine::Point2Df::Point2Df(float x, float y) : X(x), Y(y)
+{
+}
+
+CacoEngine::Point2Df::Point2Df(Vector2Df vector) : X((float)vector.X), Y((float)vector.Y)
+{
+}
+
+CacoEngine::Point2Df &CacoEngine::Point2Df::operator +=(Vector2Df difference)
+{
+    this->X += (float)difference.X;
+    this->Y += (float)difference.Y;
+
+    return *this;
+}
+
+CacoEngine::Point2Df &CacoEngine::Point2Df::operator -=(Vector2Df difference)
+{
+    this->X -= (float)difference.X;
+    this->Y -= (float)difference.Y;
+
+    return *this;
+}
+
+bool CacoEngine::Point2Df::operator ==(const Point2Df &point) const
+{
+    return (this->X == point.X && this->Y == point.Y);
+}
+
+CacoEngine::Point2Df::operator CacoEngine::Vector2Df() const
+{
+    return Vector2Df(this->X, this->Y);
+}
+
+CacoEngine::Color32::Color32(RGBA color) : R((uint8_t)color.R), G((uint8_t)color.G), B((uint8_t)color.B), A((uint8_t)color.A)
+{
+}
+
+bool CacoEngine::Color32::operator ==(const Color32 &color) const
+{
+    return (this->R == color.R &&
+            this->G == color.G &&
+            this->B == color.B &&
+            this->A == color.A);
+}
+
+CacoEngine::Color32::operator CacoEngine::RGBA() const
+{
+    return RGBA(this->R, this->G, this->B, this->A);
+}
+
 CacoEngine::Vector2Df &CacoEngine::Vector2Df::operator +=(Vector2Df difference)
 {
     this->X += difference.X;
@@ -243,15 +299,15 @@ bool CacoEngine::Vector2Df::operator ==(const Vector2Df &vector) const
 SDL_Vertex CacoEngine::Vertex2Df::GetSDLVertex()
 {
     return {
-        SDL_FPoint { (float)this->Position.X, (float)this->Position.Y },
-        SDL_Color { (uint8_t)this->Color.R, (uint8_t)this->Color.B, (uint8_t)this->Color.G, (uint8_t)this->Color.A },
-        SDL_FPoint { (float)this->TextureCoordinates.X, (float)this->TextureCoordinates.Y }
+        SDL_FPoint { this->Position.X, this->Position.Y },
+        SDL_Color { this->Color.R, this->Color.G, this->Color.B, this->Color.A },
+        SDL_FPoint { this->TextureCoordinates.X, this->TextureCoordinates.Y }
     };
 }
 
 SDL_FPoint CacoEngine::Vertex2Df::GetSDLPoint()
 {
-    return SDL_FPoint { (float)this->Position.X, (float)this->Position.Y };
+    return SDL_FPoint { this->Position.X, this->Position.Y };
 }
 
 bool CacoEngine::Vertex2Df::Equals(CacoEngine::Vertex2Df& vertex)